@@ -0,0 +1,175 @@
+#ifndef CLOCK_FIELDS_H_
+#define CLOCK_FIELDS_H_
+
+#include <stdint.h>
+
+#include "timeFormat.h"
+
+// ============================================================================
+// Incremental HH:MM:SS.mmm counter
+//
+// Keeps the displayed time as separate fields that carry on rollover, so a
+// frame advances it with a couple of compares instead of dividing the whole
+// millisecond count again. advanceTo() returns a bitmask of the fields that
+// changed, which the renderer uses to touch only those digit cells;
+// retreatTo() does the same with borrows for a time counting down.
+// ============================================================================
+
+enum ClockFieldMask : uint32_t {
+    CLOCK_MS  = 1U << 0,
+    CLOCK_SEC = 1U << 1,
+    CLOCK_MIN = 1U << 2,
+    CLOCK_HR  = 1U << 3,
+    CLOCK_ALL = CLOCK_MS | CLOCK_SEC | CLOCK_MIN | CLOCK_HR
+};
+
+// Character cells of each field within the "HH:MM:SS.mmm" text
+static constexpr uint32_t CLOCK_HR_CELL  = 0U;
+static constexpr uint32_t CLOCK_MIN_CELL = 3U;
+static constexpr uint32_t CLOCK_SEC_CELL = 6U;
+static constexpr uint32_t CLOCK_MS_CELL  = 9U;
+
+// Readout cells (bit i = character i) covered by the fields in 'mask'; each
+// field owns its digits plus the separator that follows it.
+static constexpr uint32_t clockFieldCells(uint32_t mask)
+{
+    return ((mask & CLOCK_HR) ? (0x7U << CLOCK_HR_CELL) : 0U) |
+           ((mask & CLOCK_MIN) ? (0x7U << CLOCK_MIN_CELL) : 0U) |
+           ((mask & CLOCK_SEC) ? (0x7U << CLOCK_SEC_CELL) : 0U) |
+           ((mask & CLOCK_MS) ? (0x7U << CLOCK_MS_CELL) : 0U);
+}
+
+class ClockCounter {
+public:
+    // Beyond this jump a full recompute is cheaper than stepping the carries
+    static constexpr uint32_t MAX_STEP_MS = 60000U;
+
+    ClockCounter() { set(0U); }
+
+    // Jumps straight to 'totalMs'. Uses divisions; meant for resets, channel
+    // switches and other discontinuities. Returns CLOCK_ALL.
+    uint32_t set(uint32_t totalMs)
+    {
+        const uint32_t totalSec = totalMs / 1000U;
+        const uint32_t totalMin = totalSec / 60U;
+        m_totalMs = totalMs;
+        m_ms = static_cast<uint16_t>(totalMs - totalSec * 1000U);
+        m_sec = static_cast<uint8_t>(totalSec - totalMin * 60U);
+        m_min = static_cast<uint8_t>(totalMin % 60U);
+        m_hr = static_cast<uint8_t>((totalMin / 60U) % 100U);
+        return CLOCK_ALL;
+    }
+
+    // Moves forward to 'totalMs' and returns which fields changed. Going
+    // backwards or jumping far falls back to set().
+    uint32_t advanceTo(uint32_t totalMs)
+    {
+        if (totalMs == m_totalMs) {
+            return 0U;
+        }
+        if ((totalMs < m_totalMs) || ((totalMs - m_totalMs) > MAX_STEP_MS)) {
+            return set(totalMs);
+        }
+
+        uint32_t ms = m_ms + (totalMs - m_totalMs);
+        m_totalMs = totalMs;
+
+        uint32_t changed = CLOCK_MS;
+        while (ms >= 1000U) {
+            ms -= 1000U;
+            changed |= CLOCK_SEC;
+            if (++m_sec < 60U) {
+                continue;
+            }
+            m_sec = 0U;
+            changed |= CLOCK_MIN;
+            if (++m_min < 60U) {
+                continue;
+            }
+            m_min = 0U;
+            changed |= CLOCK_HR;
+            if (++m_hr >= 100U) {
+                m_hr = 0U;
+            }
+        }
+        m_ms = static_cast<uint16_t>(ms);
+        return changed;
+    }
+
+    // Moves back to 'totalMs' and returns which fields changed. Going
+    // forwards or jumping far falls back to set().
+    uint32_t retreatTo(uint32_t totalMs)
+    {
+        if (totalMs == m_totalMs) {
+            return 0U;
+        }
+        if ((totalMs > m_totalMs) || ((m_totalMs - totalMs) > MAX_STEP_MS)) {
+            return set(totalMs);
+        }
+
+        int32_t ms = static_cast<int32_t>(m_ms) - static_cast<int32_t>(m_totalMs - totalMs);
+        m_totalMs = totalMs;
+
+        uint32_t changed = CLOCK_MS;
+        while (ms < 0) {
+            ms += 1000;
+            changed |= CLOCK_SEC;
+            if (m_sec > 0U) {
+                m_sec--;
+                continue;
+            }
+            m_sec = 59U;
+            changed |= CLOCK_MIN;
+            if (m_min > 0U) {
+                m_min--;
+                continue;
+            }
+            m_min = 59U;
+            changed |= CLOCK_HR;
+            m_hr = (m_hr > 0U) ? static_cast<uint8_t>(m_hr - 1U) : 99U;
+        }
+        m_ms = static_cast<uint16_t>(ms);
+        return changed;
+    }
+
+    // Either direction
+    uint32_t moveTo(uint32_t totalMs)
+    {
+        return (totalMs >= m_totalMs) ? advanceTo(totalMs) : retreatTo(totalMs);
+    }
+
+    // Writes the fields selected by 'mask' into an "HH:MM:SS.mmm" buffer;
+    // the other characters are left alone.
+    void format(uint32_t mask, char (&out)[TIME_TEXT_LEN + 1U]) const
+    {
+        if (mask & CLOCK_HR) {
+            timeFormatPutPair(&out[CLOCK_HR_CELL], m_hr);
+            out[2] = ':';
+        }
+        if (mask & CLOCK_MIN) {
+            timeFormatPutPair(&out[CLOCK_MIN_CELL], m_min);
+            out[5] = ':';
+        }
+        if (mask & CLOCK_SEC) {
+            timeFormatPutPair(&out[CLOCK_SEC_CELL], m_sec);
+            out[8] = '.';
+        }
+        if (mask & CLOCK_MS) {
+            const uint32_t hundreds = m_ms / 100U;   // 16-bit value, lowered to a multiply
+            out[CLOCK_MS_CELL] = static_cast<char>('0' + hundreds);
+            timeFormatPutPair(&out[CLOCK_MS_CELL + 1U], m_ms - hundreds * 100U);
+        }
+        out[TIME_TEXT_LEN] = '\0';
+    }
+
+    uint32_t totalMs() const { return m_totalMs; }
+
+private:
+    uint32_t m_totalMs;
+    uint16_t m_ms;
+    uint8_t m_sec;
+    uint8_t m_min;
+    uint8_t m_hr;
+};
+
+#endif // CLOCK_FIELDS_H_
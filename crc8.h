@@ -0,0 +1,28 @@
+#ifndef CRC8_H_
+#define CRC8_H_
+
+#include <stdint.h>
+
+// ============================================================================
+// CRC-8 (poly 0x07, init 0, no reflection), one nibble at a time
+//
+// Small enough to run inside a critical section: two table lookups per byte.
+// ============================================================================
+
+static const uint8_t CRC8_NIBBLE[16] = {
+    0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15,
+    0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D
+};
+
+static inline uint8_t crc8(const uint8_t *data, uint32_t length)
+{
+    uint32_t crc = 0U;
+    for (uint32_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = ((crc << 4) & 0xFFU) ^ CRC8_NIBBLE[crc >> 4];
+        crc = ((crc << 4) & 0xFFU) ^ CRC8_NIBBLE[crc >> 4];
+    }
+    return static_cast<uint8_t>(crc);
+}
+
+#endif // CRC8_H_
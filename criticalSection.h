@@ -0,0 +1,34 @@
+#ifndef CRITICAL_SECTION_H_
+#define CRITICAL_SECTION_H_
+
+#include <stdbool.h>
+
+extern "C" {
+#include "driverlib/interrupt.h"
+}
+
+// ============================================================================
+// Interrupt-masking scope guard
+//
+// Masks interrupts for the few instructions that touch state shared with an
+// ISR, so thread and ISR updates cannot interleave. Restores the previous
+// state on exit, so sections nest.
+// ============================================================================
+class CriticalSection {
+public:
+    CriticalSection() : m_wasDisabled(IntMasterDisable()) {}
+    ~CriticalSection()
+    {
+        if (!m_wasDisabled) {
+            IntMasterEnable();
+        }
+    }
+
+    CriticalSection(const CriticalSection &) = delete;
+    CriticalSection &operator=(const CriticalSection &) = delete;
+
+private:
+    bool m_wasDisabled;
+};
+
+#endif // CRITICAL_SECTION_H_
@@ -0,0 +1,237 @@
+#ifndef DIGIT_CACHE_H_
+#define DIGIT_CACHE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+extern "C" {
+#include "grlib/grlib.h"
+}
+
+#include "lcdFramebuffer.h"
+#include "screenLayout.h"
+#include "staticUi.h"
+
+// ============================================================================
+// Digit glyphs for the time readout
+//
+// A DigitReadout draws each character of a fixed-pitch string into its own
+// cell, and only the characters that changed since the last frame, so a
+// running millisecond field costs one or two cells per update instead of a
+// full string draw. The cells come from a glyph source:
+//   - DigitCache rasterizes the glyphs once, through GrLib, into packed
+//     RGB565 cells in SRAM and blits them
+//   - RleDigits decodes a run-length-encoded font from flash (see
+//     staticUi.h) straight into span fills, so a large font costs no SRAM
+// A glyph source provides CELL_W, CELL_H and drawCell(x, y, c), which draws
+// c's cell (blank for characters it does not have) with its top-left at x, y.
+// ============================================================================
+
+static constexpr char DIGIT_CACHE_GLYPHS[] = "0123456789:.";
+static constexpr uint32_t DIGIT_CACHE_GLYPH_COUNT = sizeof(DIGIT_CACHE_GLYPHS) - 1U;
+
+// Index of 'c' in DIGIT_CACHE_GLYPHS, or -1
+static inline int32_t digitGlyphIndex(char c)
+{
+    if ((c >= '0') && (c <= '9')) {
+        return c - '0';
+    }
+    if (c == ':') {
+        return 10;
+    }
+    if (c == '.') {
+        return 11;
+    }
+    return -1;
+}
+
+// 24-bit GrLib colour as an RGB565 pixel in panel byte order
+static inline uint16_t digitPanelColor(uint32_t color)
+{
+    const uint32_t rgb = ((color & 0x00F80000U) >> 8) | ((color & 0x0000FC00U) >> 5) |
+                         ((color & 0x000000F8U) >> 3);
+    return static_cast<uint16_t>(((rgb & 0xFFU) << 8) | (rgb >> 8));
+}
+
+template <uint32_t W, uint32_t H>
+class DigitCache {
+public:
+    static constexpr uint32_t CELL_W = W;
+    static constexpr uint32_t CELL_H = H;
+    static constexpr uint32_t CELL_PIXELS = CELL_W * CELL_H;
+
+    // Rasterizes every glyph in 'font' as fg-on-bg, centered in its cell.
+    // The font must fit in CELL_W x CELL_H (e.g. 6x8 for g_sFontFixed6x8).
+    void render(const tFont *font, uint32_t fg, uint32_t bg)
+    {
+        for (uint32_t i = 0; i < DIGIT_CACHE_GLYPH_COUNT; i++) {
+            tDisplay display;
+            LcdCanvas canvas;
+            lcdCanvasDisplayInit(display, canvas, m_cells[i], CELL_W, CELL_H);
+
+            tContext context;
+            GrContextInit(&context, &display);
+            GrContextFontSet(&context, font);
+
+            tRectangle cell = {0, 0, CELL_W - 1, CELL_H - 1};
+            GrContextForegroundSet(&context, bg);
+            GrRectFill(&context, &cell);
+
+            const char *glyph = &DIGIT_CACHE_GLYPHS[i];
+            const int32_t w = GrStringWidthGet(&context, glyph, 1);
+            const int32_t h = GrStringHeightGet(&context);
+            GrContextForegroundSet(&context, fg);
+            GrContextBackgroundSet(&context, bg);
+            GrStringDraw(&context, glyph, 1,
+                         (static_cast<int32_t>(CELL_W) - w) / 2,
+                         (static_cast<int32_t>(CELL_H) - h) / 2, true);
+        }
+        m_background = digitPanelColor(bg);
+    }
+
+    // Cell for 'c', or nullptr if it is not a cached glyph.
+    const uint16_t *glyph(char c) const
+    {
+        const int32_t i = digitGlyphIndex(c);
+        return (i < 0) ? nullptr : m_cells[i];
+    }
+
+    void drawCell(int32_t x, int32_t y, char c) const
+    {
+        const uint16_t *cell = glyph(c);
+        if (cell != nullptr) {
+            lcdBlit(x, y, CELL_W, CELL_H, cell);
+        } else {
+            lcdSpanBegin(x, y, CELL_W, CELL_H);
+            lcdSpanFill(m_background, CELL_PIXELS);
+        }
+    }
+
+private:
+    uint16_t m_cells[DIGIT_CACHE_GLYPH_COUNT][CELL_PIXELS];
+    uint16_t m_background = 0U;
+};
+
+// ============================================================================
+// Glyphs decoded from an RLE font in flash
+// ============================================================================
+template <uint32_t W, uint32_t H>
+class RleDigits {
+public:
+    static constexpr uint32_t CELL_W = W;
+    static constexpr uint32_t CELL_H = H;
+
+    // 'font' must have W x H cells and the DIGIT_CACHE_GLYPHS glyphs in order,
+    // as tools/gen_static_ui.py writes them.
+    RleDigits(const RleFont &font, uint32_t fg, uint32_t bg)
+        : m_font(font), m_fg(digitPanelColor(fg)), m_bg(digitPanelColor(bg))
+    {
+    }
+
+    void drawCell(int32_t x, int32_t y, char c) const
+    {
+        lcdSpanBegin(x, y, CELL_W, CELL_H);
+        const int32_t i = digitGlyphIndex(c);
+        if (i < 0) {
+            lcdSpanFill(m_bg, CELL_W * CELL_H);
+            return;
+        }
+        const uint8_t *run = &m_font.runs[m_font.offsets[i]];
+        const uint8_t *end = &m_font.runs[m_font.offsets[i + 1]];
+        bool lit = false;
+        for (; run != end; run++) {
+            if (*run != 0U) {
+                lcdSpanFill(lit ? m_fg : m_bg, *run);
+            }
+            lit = !lit;
+        }
+    }
+
+private:
+    const RleFont &m_font;
+    uint16_t m_fg;
+    uint16_t m_bg;
+};
+
+// ============================================================================
+// Fixed-cell readout drawn from a glyph source
+// ============================================================================
+template <typename Glyphs, uint32_t MAX_CELLS>
+class DigitReadout {
+    static_assert(MAX_CELLS <= 32U, "DigitReadout tracks dirty cells in a 32-bit mask");
+
+public:
+    // 'box' comes from the layout, sized for MAX_CELLS cells of this pitch.
+    constexpr explicit DigitReadout(const TextBox &box) : m_x(box.x), m_y(box.y) {}
+
+    // Stages new text; characters outside the glyph set are drawn as blanks.
+    // Switching glyph sources (e.g. to another colour) redraws every cell.
+    void set(const char *text, const Glyphs &glyphs)
+    {
+        setCells(text, ALL_CELLS, glyphs);
+    }
+
+    // Stages only the cells in 'cellMask' (bit i = character i), e.g. the
+    // fields a ClockCounter reported as changed. Other cells keep their text.
+    void setCells(const char *text, uint32_t cellMask, const Glyphs &glyphs)
+    {
+        if (&glyphs != m_glyphs) {
+            m_glyphs = &glyphs;
+            invalidate();
+        }
+        bool ended = false;
+        for (uint32_t i = 0; i < MAX_CELLS; i++) {
+            ended = ended || (text[i] == '\0');
+            if ((cellMask & (1U << i)) == 0U) {
+                continue;
+            }
+            const char c = ended ? ' ' : text[i];
+            if (c != m_shown[i]) {
+                m_dirty |= 1U << i;
+            }
+            m_next[i] = c;
+        }
+    }
+
+    void invalidate()
+    {
+        memset(m_shown, 0, sizeof(m_shown));
+        m_dirty = ALL_CELLS;
+    }
+
+    // Draws every cell whose character changed. Returns true if any did.
+    bool draw()
+    {
+        if ((m_glyphs == nullptr) || (m_dirty == 0U)) {
+            return false;
+        }
+        bool painted = false;
+        for (uint32_t i = 0; i < MAX_CELLS; i++) {
+            if (((m_dirty & (1U << i)) == 0U) || (m_next[i] == m_shown[i])) {
+                continue;
+            }
+            m_glyphs->drawCell(m_x + static_cast<int32_t>(i * Glyphs::CELL_W), m_y, m_next[i]);
+            m_shown[i] = m_next[i];
+            painted = true;
+        }
+        m_dirty = 0U;
+        return painted;
+    }
+
+    int32_t x() const { return m_x; }
+    int32_t y() const { return m_y; }
+
+private:
+    static constexpr uint32_t ALL_CELLS =
+        (MAX_CELLS == 32U) ? 0xFFFFFFFFU : ((1U << MAX_CELLS) - 1U);
+
+    int32_t m_x;
+    int32_t m_y;
+    const Glyphs *m_glyphs = nullptr;
+    char m_next[MAX_CELLS] = {};
+    char m_shown[MAX_CELLS] = {};
+    uint32_t m_dirty = 0U;
+};
+
+#endif // DIGIT_CACHE_H_
@@ -0,0 +1,27 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "driverlib/sysctl.h"
+#include "driverlib/udma.h"
+}
+
+#include "dmaControl.h"
+
+static tDMAControlTable sDMAControlTable[64] __attribute__((aligned(1024)));
+static bool sInitialized = false;
+
+void dmaControlInit()
+{
+    if (sInitialized) {
+        return;
+    }
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA)) {
+    }
+
+    uDMAEnable();
+    uDMAControlBaseSet(sDMAControlTable);
+    sInitialized = true;
+}
@@ -0,0 +1,15 @@
+#ifndef DMA_CONTROL_H_
+#define DMA_CONTROL_H_
+
+// ============================================================================
+// uDMA controller ownership
+//
+// The uDMA channel control table must be 1024-byte aligned and there is only
+// one per device, so every DMA user in the firmware shares this one.
+// ============================================================================
+
+// Enables the uDMA peripheral and installs the control table. Safe to call
+// from each module that needs DMA; only the first call does anything.
+void dmaControlInit();
+
+#endif // DMA_CONTROL_H_
@@ -0,0 +1,217 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+}
+
+#include "edgeButton.h"
+#include "timebase.h"
+
+const EdgeButtonPin EDGE_S1 = {SYSCTL_PERIPH_GPIOH, GPIO_PORTH_BASE, GPIO_PIN_1, INT_GPIOH};
+const EdgeButtonPin EDGE_S2 = {SYSCTL_PERIPH_GPIOK, GPIO_PORTK_BASE, GPIO_PIN_6, INT_GPIOK};
+const EdgeButtonPin EDGE_USR_SW1 = {SYSCTL_PERIPH_GPIOJ, GPIO_PORTJ_BASE, GPIO_PIN_0, INT_GPIOJ};
+const EdgeButtonPin EDGE_GATE_PL4 = {SYSCTL_PERIPH_GPIOL, GPIO_PORTL_BASE, GPIO_PIN_4, INT_GPIOL};
+
+// Buttons sharing a port share its interrupt vector
+static constexpr uint32_t MAX_EDGE_BUTTONS = 4U;
+static EdgeButton *sButtons[MAX_EDGE_BUTTONS] = {};
+static uint32_t sButtonCount = 0;
+
+static void edgeButtonPortISR()
+{
+    const uint64_t now = timebaseNow();
+    for (uint32_t i = 0; i < sButtonCount; i++) {
+        EdgeButton &b = *sButtons[i];
+        const uint32_t port = b.pin().port;
+        const uint32_t status = GPIOIntStatus(port, true);
+        if (status & b.pin().pin) {
+            GPIOIntClear(port, b.pin().pin);
+            b.onEdgeISR(now);
+        }
+    }
+}
+
+// ============================================================================
+// EdgeButton
+// ============================================================================
+EdgeButton::EdgeButton(const EdgeButtonPin &pin)
+    : m_pin(pin), m_edges(), m_gestures(), m_longPressTicks(0), m_multiClickTicks(0),
+      m_debounceMs(30), m_debounceTicks(0),
+      m_lastAcceptTicks(0), m_pressTicks(0), m_releaseTicks(0),
+      m_pressed(false), m_pressEvent(false), m_releaseEvent(false),
+      m_settled(true), m_replay(false), m_replayLevel(false)
+{
+}
+
+void EdgeButton::begin()
+{
+    m_debounceTicks = timebaseMsToTicks(m_debounceMs);
+
+    SysCtlPeripheralEnable(m_pin.periph);
+    while (!SysCtlPeripheralReady(m_pin.periph)) {
+    }
+
+    GPIOPinTypeGPIOInput(m_pin.port, m_pin.pin);
+    GPIOPadConfigSet(m_pin.port, m_pin.pin, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
+    m_pressed = readPressed();
+
+    bool portRegistered = false;
+    for (uint32_t i = 0; i < sButtonCount; i++) {
+        portRegistered |= (sButtons[i]->pin().port == m_pin.port);
+    }
+    if (sButtonCount < MAX_EDGE_BUTTONS) {
+        sButtons[sButtonCount++] = this;
+    }
+
+    GPIOIntTypeSet(m_pin.port, m_pin.pin, GPIO_BOTH_EDGES);
+    GPIOIntClear(m_pin.port, m_pin.pin);
+    if (!portRegistered) {
+        GPIOIntRegister(m_pin.port, edgeButtonPortISR);
+        IntPrioritySet(m_pin.interrupt, 0x20);   // just below the timebase
+    }
+    GPIOIntEnable(m_pin.port, m_pin.pin);
+}
+
+void EdgeButton::setDebounceMs(uint32_t ms)
+{
+    m_debounceMs = ms;
+    m_debounceTicks = timebaseMsToTicks(ms);
+}
+
+void EdgeButton::setLongPressMs(uint32_t ms)
+{
+    m_longPressTicks = timebaseMsToTicks(ms);
+    m_gestures.configure(m_longPressTicks, m_multiClickTicks);
+}
+
+void EdgeButton::setMultiClickMs(uint32_t ms)
+{
+    m_multiClickTicks = timebaseMsToTicks(ms);
+    m_gestures.configure(m_longPressTicks, m_multiClickTicks);
+}
+
+bool EdgeButton::readPressed() const
+{
+    if (m_replay) {
+        return m_replayLevel;
+    }
+    return GPIOPinRead(m_pin.port, m_pin.pin) == 0;   // active low
+}
+
+void EdgeButton::onEdgeISR(uint64_t nowTicks)
+{
+    if (m_replay) {
+        return;   // the pin is not the source of edges while replaying
+    }
+    const Edge edge = {nowTicks, readPressed()};
+    m_edges.push(edge);   // a full queue means a burst of bounces; drop them
+}
+
+void EdgeButton::setReplay(bool on)
+{
+    m_replayLevel = false;
+    m_replay = on;
+}
+
+void EdgeButton::replayEdge(bool pressed, uint64_t nowTicks)
+{
+    m_replayLevel = pressed;
+    const Edge edge = {nowTicks, pressed};
+    m_edges.push(edge);
+}
+
+void EdgeButton::accept(bool pressed, uint64_t ticks)
+{
+    m_pressed = pressed;
+    m_lastAcceptTicks = ticks;
+    m_settled = false;
+    if (pressed) {
+        m_pressTicks = ticks;
+        m_pressEvent = true;
+        m_gestures.press(ticks);
+    } else {
+        m_releaseTicks = ticks;
+        m_releaseEvent = true;
+        m_gestures.release(ticks);
+    }
+}
+
+void EdgeButton::tick()
+{
+    if (m_settled && m_edges.empty() && !m_gestures.pending()) {
+        return;
+    }
+
+    Edge edge;
+    while (m_edges.pop(edge)) {
+        // Ignore everything inside the window after an accepted edge
+        if ((edge.ticks - m_lastAcceptTicks) < m_debounceTicks) {
+            continue;
+        }
+        if (edge.pressed != m_pressed) {
+            accept(edge.pressed, edge.ticks);
+        }
+    }
+
+    // Once the window has passed, make sure the last ignored bounce did not
+    // leave us on the wrong level.
+    const uint64_t now = timebaseNow();
+    if (!m_settled && ((now - m_lastAcceptTicks) >= m_debounceTicks)) {
+        const bool level = readPressed();
+        if (level != m_pressed) {
+            accept(level, now);
+        } else {
+            m_settled = true;
+        }
+    }
+
+    m_gestures.poll(now);
+}
+
+bool EdgeButton::wasPressed()
+{
+    const bool event = m_pressEvent;
+    m_pressEvent = false;
+    return event;
+}
+
+bool EdgeButton::wasReleased()
+{
+    const bool event = m_releaseEvent;
+    m_releaseEvent = false;
+    return event;
+}
+
+// ============================================================================
+// InputSource
+// ============================================================================
+void EdgeButton::configure(const InputTiming &timing)
+{
+    begin();
+    setDebounceMs(timing.debounceMs);
+    setLongPressMs(timing.longPressMs);
+    setMultiClickMs(timing.multiClickMs);
+}
+
+bool EdgeButton::takePress(uint64_t &ticks)
+{
+    if (!wasPressed()) {
+        return false;
+    }
+    ticks = m_pressTicks;
+    return true;
+}
+
+bool EdgeButton::takeRelease(uint64_t &ticks)
+{
+    if (!wasReleased()) {
+        return false;
+    }
+    ticks = m_releaseTicks;
+    return true;
+}
@@ -0,0 +1,126 @@
+#ifndef EDGE_BUTTON_H_
+#define EDGE_BUTTON_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "spscQueue.h"
+#include "gestureRecognizer.h"
+#include "inputSource.h"
+
+// ============================================================================
+// Interrupt-driven button with timestamped edges
+//
+// A GPIO edge interrupt stamps every transition with the hardware timebase
+// and pushes it into a lock-free ring buffer. tick() debounces on those
+// timestamps: the first edge of a burst is accepted and the following
+// debounce window is ignored, so wasPressed() reports when the press really
+// happened instead of when it was first polled.
+//
+// Same interface as Button, so it can be swapped in without touching the
+// callers; pressTicks()/releaseTicks() expose the edge timestamps. It is
+// also an input source (inputSource.h) whose events carry those
+// timestamps, e.g. a photogate's with the precision of its port interrupt.
+//
+// Long presses and multi-clicks are recognized on the same accepted edges
+// (see gestureRecognizer.h). tick() only has work to do while the button
+// is bouncing or a gesture deadline is pending.
+//
+// In replay mode (latencyBench.h) the pin is ignored: replayEdge() supplies
+// the edges, and the level tick() settles on, in place of the interrupt.
+// ============================================================================
+
+// Pin description for an active-low push button (pull-up enabled).
+struct EdgeButtonPin {
+    uint32_t periph;
+    uint32_t port;
+    uint8_t pin;
+    uint32_t interrupt;
+};
+
+// BOOSTXL-EDUMKII buttons on BoosterPack 1 of the EK-TM4C1294XL
+extern const EdgeButtonPin EDGE_S1;   // PH1
+extern const EdgeButtonPin EDGE_S2;   // PK6
+
+// LaunchPad user switch
+extern const EdgeButtonPin EDGE_USR_SW1;   // PJ0
+
+// Light barrier (photogate, open collector) on the LaunchPad's PL4
+extern const EdgeButtonPin EDGE_GATE_PL4;
+
+class EdgeButton : public InputSource<EdgeButton> {
+public:
+    explicit EdgeButton(const EdgeButtonPin &pin);
+
+    // Configures the pin and enables its edge interrupt. Call after
+    // timebaseInit(), since the debounce window is kept in timebase ticks.
+    void begin();
+
+    // Kept for interface compatibility with Button; edges are not sampled.
+    void setTickIntervalMs(uint32_t) {}
+    void setDebounceMs(uint32_t ms);
+
+    // Gesture thresholds, 0 to disable. Call after timebaseInit().
+    void setLongPressMs(uint32_t ms);
+    void setMultiClickMs(uint32_t ms);
+
+    // Drains captured edges and updates the debounced state. Cheap when the
+    // button is idle: one empty-queue check.
+    void tick();
+
+    bool wasPressed();
+    bool wasReleased();
+    bool isPressed() const { return m_pressed; }
+
+    // Timebase ticks of the most recent accepted press / release edge.
+    uint64_t pressTicks() const { return m_pressTicks; }
+    uint64_t releaseTicks() const { return m_releaseTicks; }
+
+    // Finished long presses and click sequences
+    GestureRecognizer &gestures() { return m_gestures; }
+
+    // Called by the port interrupt handler.
+    void onEdgeISR(uint64_t nowTicks);
+
+    // Replay mode. Switch it while the button is released; replayEdge() is
+    // called from the timebase heartbeat.
+    void setReplay(bool on);
+    void replayEdge(bool pressed, uint64_t nowTicks);
+
+    const EdgeButtonPin &pin() const { return m_pin; }
+
+    // InputSource
+    void configure(const InputTiming &timing);
+    void poll(uint64_t) { tick(); }
+    bool takePress(uint64_t &ticks);
+    bool takeRelease(uint64_t &ticks);
+    GestureRecognizer &recognizer() { return m_gestures; }
+
+private:
+    struct Edge {
+        uint64_t ticks;
+        bool pressed;
+    };
+
+    bool readPressed() const;
+    void accept(bool pressed, uint64_t ticks);
+
+    const EdgeButtonPin &m_pin;
+    SpscQueue<Edge, 16> m_edges;
+    GestureRecognizer m_gestures;
+    uint64_t m_longPressTicks;
+    uint64_t m_multiClickTicks;
+    uint32_t m_debounceMs;
+    uint64_t m_debounceTicks;
+    uint64_t m_lastAcceptTicks;
+    uint64_t m_pressTicks;
+    uint64_t m_releaseTicks;
+    bool m_pressed;
+    bool m_pressEvent;
+    bool m_releaseEvent;
+    bool m_settled;
+    volatile bool m_replay;
+    volatile bool m_replayLevel;
+};
+
+#endif // EDGE_BUTTON_H_
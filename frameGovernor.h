@@ -0,0 +1,64 @@
+#ifndef FRAME_GOVERNOR_H_
+#define FRAME_GOVERNOR_H_
+
+#include <stdint.h>
+
+// ============================================================================
+// Frame-rate governor
+//
+// Decides how often the display event runs. Each frame reports what it cost
+// (CPU cycles spent rendering, and how long the background flush kept the
+// SPI busy); the governor keeps a smoothed estimate and stretches the frame
+// period whenever rendering would take more than its CPU share or the panel
+// could not keep up, and shrinks it back to the target rate when frames get
+// cheap again. Input events run between frames, so a bounded render share
+// means bounded input latency.
+// ============================================================================
+class FrameGovernor {
+public:
+    // targetFps: fastest refresh wanted
+    // cpuBudgetPct: share of the CPU rendering may use (1..100)
+    FrameGovernor(uint32_t targetFps, uint32_t cpuBudgetPct)
+        : m_minPeriodMs((1000U + targetFps - 1U) / targetFps),
+          m_cpuBudgetPct(cpuBudgetPct),
+          m_cyclesPerMs(1U),
+          m_avgRenderCycles(0),
+          m_avgFlushCycles(0),
+          m_periodMs(m_minPeriodMs)
+    {
+    }
+
+    void setClock(uint32_t sysClock) { m_cyclesPerMs = sysClock / 1000U; }
+
+    // Reports a finished frame. flushCycles is the previous flush's SPI
+    // time (0 when drawing directly to the panel).
+    void frameDone(uint32_t renderCycles, uint32_t flushCycles)
+    {
+        // 1/8 exponential moving average; reacts within a few frames
+        m_avgRenderCycles += (static_cast<int32_t>(renderCycles) - m_avgRenderCycles) / 8;
+        m_avgFlushCycles += (static_cast<int32_t>(flushCycles) - m_avgFlushCycles) / 8;
+
+        const uint32_t cpuMs =
+            (static_cast<uint32_t>(m_avgRenderCycles) / m_cyclesPerMs) * 100U / m_cpuBudgetPct;
+        const uint32_t spiMs = static_cast<uint32_t>(m_avgFlushCycles) / m_cyclesPerMs + 1U;
+
+        uint32_t period = (cpuMs > spiMs) ? cpuMs : spiMs;
+        if (period < m_minPeriodMs) {
+            period = m_minPeriodMs;
+        }
+        m_periodMs = period;
+    }
+
+    uint32_t periodMs() const { return m_periodMs; }
+    uint32_t fps() const { return 1000U / m_periodMs; }
+
+private:
+    uint32_t m_minPeriodMs;
+    uint32_t m_cpuBudgetPct;
+    uint32_t m_cyclesPerMs;
+    int32_t m_avgRenderCycles;
+    int32_t m_avgFlushCycles;
+    uint32_t m_periodMs;
+};
+
+#endif // FRAME_GOVERNOR_H_
@@ -0,0 +1,125 @@
+#ifndef GESTURE_RECOGNIZER_H_
+#define GESTURE_RECOGNIZER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Long-press and multi-click recognition on debounced transitions
+//
+// Fed with the accepted press/release timestamps of one button, it keeps a
+// single deadline: the long-press time while the button is held, or the
+// multi-click window after a release. poll() compares that deadline with
+// the current time, so the cost per tick is constant and nothing is pending
+// while the button is idle.
+//
+//   - A long press fires once, while still held. It ends the click
+//     sequence, so the presses that led up to it are not reported as clicks.
+//   - A click sequence ends when no new press follows a release within the
+//     multi-click window. It is reported with its press count and the time
+//     of its first press.
+//
+// A threshold of 0 disables that gesture: without a window every release
+// completes a single click immediately.
+// ============================================================================
+class GestureRecognizer {
+public:
+    void configure(uint64_t longPressTicks, uint64_t multiClickTicks)
+    {
+        m_longPressTicks = longPressTicks;
+        m_multiClickTicks = multiClickTicks;
+    }
+
+    void press(uint64_t ticks)
+    {
+        const bool inWindow = (m_clicks > 0U) && (m_deadline != NONE) && !m_down;
+        if (inWindow && (m_clicks < MAX_CLICKS)) {
+            m_clicks++;
+        } else if (!inWindow) {
+            m_clicks = 1U;
+            m_firstTicks = ticks;
+        }
+        m_down = true;
+        m_pressTicks = ticks;
+        m_deadline = (m_longPressTicks != 0U) ? (ticks + m_longPressTicks) : NONE;
+    }
+
+    void release(uint64_t ticks)
+    {
+        m_down = false;
+        if (m_clicks == 0U) {   // the long press already ended the sequence
+            m_deadline = NONE;
+            return;
+        }
+        if (m_multiClickTicks == 0U) {
+            finishClicks();
+            return;
+        }
+        m_deadline = ticks + m_multiClickTicks;
+    }
+
+    // Fires whatever gesture is due at 'nowTicks'.
+    void poll(uint64_t nowTicks)
+    {
+        if ((m_deadline == NONE) || (nowTicks < m_deadline)) {
+            return;
+        }
+        m_deadline = NONE;
+        if (m_down) {
+            m_longReady = true;
+            m_longTicks = m_pressTicks;
+            m_clicks = 0U;
+        } else {
+            finishClicks();
+        }
+    }
+
+    bool pending() const { return m_deadline != NONE; }
+
+    // Consumes a long press; 'atTicks' is when that press started.
+    bool takeLongPress(uint64_t &atTicks)
+    {
+        if (!m_longReady) {
+            return false;
+        }
+        m_longReady = false;
+        atTicks = m_longTicks;
+        return true;
+    }
+
+    // Consumes a finished click sequence: its press count (0 if none) and
+    // the time of its first press.
+    uint32_t takeClicks(uint64_t &atTicks)
+    {
+        const uint32_t clicks = m_readyClicks;
+        m_readyClicks = 0U;
+        atTicks = m_readyTicks;
+        return clicks;
+    }
+
+private:
+    static constexpr uint64_t NONE = ~static_cast<uint64_t>(0);
+    static constexpr uint32_t MAX_CLICKS = 255U;
+
+    void finishClicks()
+    {
+        m_readyClicks = m_clicks;
+        m_readyTicks = m_firstTicks;
+        m_clicks = 0U;
+        m_deadline = NONE;
+    }
+
+    uint64_t m_longPressTicks = 0U;
+    uint64_t m_multiClickTicks = 0U;
+    uint64_t m_deadline = NONE;
+    uint64_t m_pressTicks = 0U;
+    uint64_t m_firstTicks = 0U;
+    uint64_t m_longTicks = 0U;
+    uint64_t m_readyTicks = 0U;
+    uint32_t m_clicks = 0U;
+    uint32_t m_readyClicks = 0U;
+    bool m_down = false;
+    bool m_longReady = false;
+};
+
+#endif // GESTURE_RECOGNIZER_H_
@@ -0,0 +1,79 @@
+#ifndef INPUT_EVENTS_H_
+#define INPUT_EVENTS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "spscQueue.h"
+
+// ============================================================================
+// Input events from the sampling interrupt to the application
+//
+// Buttons are debounced in the timebase heartbeat, which nothing in the
+// main loop can delay, and every accepted transition is posted here with
+// the timestamp of the edge. The main loop drains the queue in order, so a
+// slow frame only postpones the handlers: two quick presses during one
+// redraw are still two presses, each with its own time.
+//
+// Coalescing only touches what is not timing-relevant:
+//   - The on-screen pressed state follows the inputs' debounced level, not
+//     the event stream, so a press/release pair drained in one pass never
+//     repaints a button twice.
+//   - Releases only drive visual feedback. When the queue is nearly full
+//     they are dropped (and counted) first, keeping the last
+//     INPUT_EVENT_RESERVE slots for presses and gestures.
+// ============================================================================
+
+enum InputEventKind : uint8_t {
+    INPUT_PRESS      = 0,
+    INPUT_RELEASE    = 1,
+    INPUT_LONG_PRESS = 2,   // still held after the long-press time
+    INPUT_CLICKS     = 3,   // a finished click sequence, 'count' presses
+};
+
+struct InputEvent {
+    uint64_t ticks;   // timebase ticks of the edge (first press for gestures)
+    uint8_t source;   // index of the input in its InputTable
+    uint8_t kind;     // InputEventKind
+    uint8_t count;    // presses in an INPUT_CLICKS sequence
+};
+
+static constexpr uint32_t INPUT_EVENT_RESERVE = 4U;
+
+template <uint32_t CAPACITY>
+class InputEventQueue {
+    static_assert(CAPACITY > INPUT_EVENT_RESERVE, "InputEventQueue needs room beyond the reserve");
+
+public:
+    // Producer side (sampling interrupt). Returns false if the event was
+    // dropped: a release under pressure, or anything on a full queue.
+    bool post(const InputEvent &event)
+    {
+        if ((event.kind == INPUT_RELEASE) &&
+            (m_events.size() >= (CAPACITY - INPUT_EVENT_RESERVE))) {
+            m_coalesced = m_coalesced + 1U;
+            return false;
+        }
+        if (!m_events.push(event)) {
+            m_dropped = m_dropped + 1U;
+            return false;
+        }
+        return true;
+    }
+
+    // Consumer side (main loop). Returns false when empty.
+    bool pop(InputEvent &event) { return m_events.pop(event); }
+
+    bool empty() const { return m_events.empty(); }
+
+    // Releases folded away, and timing events lost to a completely full queue
+    uint32_t coalesced() const { return m_coalesced; }
+    uint32_t dropped() const { return m_dropped; }
+
+private:
+    SpscQueue<InputEvent, CAPACITY> m_events;
+    volatile uint32_t m_coalesced = 0;
+    volatile uint32_t m_dropped = 0;
+};
+
+#endif // INPUT_EVENTS_H_
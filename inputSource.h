@@ -0,0 +1,249 @@
+#ifndef INPUT_SOURCE_H_
+#define INPUT_SOURCE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "inputEvents.h"
+#include "gestureRecognizer.h"
+#include "profiler.h"
+#include "screenLayout.h"
+#include "timebase.h"
+
+// ============================================================================
+// Input sources
+//
+// Anything that can press a button is an input source: a board switch, a
+// photogate on a spare pin, a touch overlay over the on-screen buttons.
+// Every source derives from InputSource<Derived> (CRTP), which turns what
+// the source saw into timestamped events on the shared InputEventQueue.
+// The binding in widgetTable.h names the concrete type, so each call below
+// is resolved at compile time: there is no virtual dispatch, and a source
+// adds only its own state.
+//
+// A source provides, for one heartbeat sample:
+//   void configure(const InputTiming &)   once, after timebaseInit()
+//   void poll(uint64_t nowTicks)          debounce, feed the recognizer
+//   bool takePress(uint64_t &ticks)       an accepted press and its time
+//   bool takeRelease(uint64_t &ticks)
+//   GestureRecognizer &recognizer()       already polled at nowTicks
+//   bool isPressed() const                the debounced level
+//
+// The timestamps are what the handlers act on, so a source that stamps its
+// edges in their own interrupt (EdgeButton) gives a lap or a start the
+// precision of that interrupt, however late the main loop gets to it.
+// ============================================================================
+
+// Sampling, debounce and gesture thresholds shared by an InputTable
+struct InputTiming {
+    uint32_t sampleMs;       // how often sample() runs
+    uint32_t debounceMs;
+    uint32_t longPressMs;    // 0: no long presses
+    uint32_t multiClickMs;   // 0: every release is a single click
+};
+
+template <typename Derived>
+class InputSource {
+public:
+    // Input layer (heartbeat interrupt): posts everything the source
+    // accepted since the last sample as events from 'source'
+    template <typename Queue>
+    void sample(uint8_t source, uint64_t nowTicks, Queue &queue)
+    {
+        Derived &input = self();
+        {
+            ScopedProbe probe(PROF_BUTTON_TICK);
+            input.poll(nowTicks);
+        }
+        uint64_t ticks;
+        if (input.takePress(ticks)) {
+            queue.post({ticks, source, INPUT_PRESS, 0U});
+        }
+        if (input.takeRelease(ticks)) {
+            queue.post({ticks, source, INPUT_RELEASE, 0U});
+        }
+
+        GestureRecognizer &gestures = input.recognizer();
+        if (gestures.takeLongPress(ticks)) {
+            queue.post({ticks, source, INPUT_LONG_PRESS, 0U});
+        }
+        const uint32_t clicks = gestures.takeClicks(ticks);
+        if (clicks != 0U) {
+            queue.post({ticks, source, INPUT_CLICKS, static_cast<uint8_t>(clicks)});
+        }
+    }
+
+protected:
+    InputSource() = default;
+
+private:
+    Derived &self() { return static_cast<Derived &>(*this); }
+};
+
+// ============================================================================
+// CLASS: Polled button library (Button) as a source
+//
+// The library debounces on its own samples and only reports that a
+// transition happened, so the sample that saw it is its timestamp and the
+// gestures run on a recognizer kept here.
+// ============================================================================
+template <typename Input>
+class PolledInput : public InputSource<PolledInput<Input>> {
+public:
+    explicit PolledInput(Input &input) : m_input(input) {}
+
+    void configure(const InputTiming &timing)
+    {
+        m_input.begin();
+        m_input.setTickIntervalMs(timing.sampleMs);
+        m_input.setDebounceMs(timing.debounceMs);
+        m_gestures.configure(timebaseMsToTicks(timing.longPressMs),
+                             timebaseMsToTicks(timing.multiClickMs));
+    }
+
+    void poll(uint64_t nowTicks)
+    {
+        m_nowTicks = nowTicks;
+        m_input.tick();
+    }
+
+    bool takePress(uint64_t &ticks)
+    {
+        if (!m_input.wasPressed()) {
+            return false;
+        }
+        ticks = m_nowTicks;
+        m_gestures.press(ticks);
+        return true;
+    }
+
+    bool takeRelease(uint64_t &ticks)
+    {
+        if (!m_input.wasReleased()) {
+            return false;
+        }
+        ticks = m_nowTicks;
+        m_gestures.release(ticks);
+        return true;
+    }
+
+    GestureRecognizer &recognizer()
+    {
+        m_gestures.poll(m_nowTicks);
+        return m_gestures;
+    }
+
+    bool isPressed() const { return m_input.isPressed(); }
+
+private:
+    Input &m_input;
+    GestureRecognizer m_gestures;
+    uint64_t m_nowTicks = 0U;
+};
+
+// ============================================================================
+// Touch overlay
+//
+// The overlay's driver reports where the panel is being touched, in panel
+// pixels. Any number of TouchKeys share one overlay: it is read at most once
+// per heartbeat, by whichever key samples first.
+// ============================================================================
+struct TouchPoint {
+    int16_t x, y;
+};
+
+class TouchOverlay {
+public:
+    // 'read' fills in the point and returns true while the panel is touched
+    explicit constexpr TouchOverlay(bool (*read)(TouchPoint &point)) : m_read(read) {}
+
+    // Heartbeat: the touch as of 'nowTicks'
+    bool touched(uint64_t nowTicks, TouchPoint &point)
+    {
+        if (!m_valid || (nowTicks != m_readTicks)) {
+            m_touched = m_read(m_point);
+            m_readTicks = nowTicks;
+            m_valid = true;
+        }
+        point = m_point;
+        return m_touched;
+    }
+
+private:
+    bool (*m_read)(TouchPoint &point);
+    TouchPoint m_point = {0, 0};
+    uint64_t m_readTicks = 0U;
+    bool m_touched = false;
+    bool m_valid = false;
+};
+
+// ============================================================================
+// CLASS: An on-screen button pressed through the touch overlay
+//
+// Pressed while a touch is inside its box. A change of level is accepted
+// once it has held for the debounce time and is stamped with the sample
+// that first saw it, so the debounce costs no accuracy.
+// ============================================================================
+class TouchKey : public InputSource<TouchKey> {
+public:
+    TouchKey(TouchOverlay &overlay, const BoxRect &box) : m_overlay(overlay), m_box(box) {}
+
+    void configure(const InputTiming &timing)
+    {
+        m_debounceTicks = timebaseMsToTicks(timing.debounceMs);
+        m_gestures.configure(timebaseMsToTicks(timing.longPressMs),
+                             timebaseMsToTicks(timing.multiClickMs));
+    }
+
+    void poll(uint64_t nowTicks)
+    {
+        TouchPoint p;
+        const bool inside = m_overlay.touched(nowTicks, p) && boxContains(m_box, p.x, p.y);
+        if (inside == m_pressed) {
+            m_changing = false;
+        } else if (!m_changing) {
+            m_changing = true;
+            m_changeTicks = nowTicks;
+        }
+        if (m_changing && ((nowTicks - m_changeTicks) >= m_debounceTicks)) {
+            m_changing = false;
+            m_pressed = inside;
+            if (inside) {
+                m_pressEvent = true;
+                m_gestures.press(m_changeTicks);
+            } else {
+                m_releaseEvent = true;
+                m_gestures.release(m_changeTicks);
+            }
+        }
+        m_gestures.poll(nowTicks);
+    }
+
+    bool takePress(uint64_t &ticks) { return take(m_pressEvent, ticks); }
+    bool takeRelease(uint64_t &ticks) { return take(m_releaseEvent, ticks); }
+    GestureRecognizer &recognizer() { return m_gestures; }
+    bool isPressed() const { return m_pressed; }
+
+private:
+    bool take(bool &event, uint64_t &ticks)
+    {
+        if (!event) {
+            return false;
+        }
+        event = false;
+        ticks = m_changeTicks;
+        return true;
+    }
+
+    TouchOverlay &m_overlay;
+    const BoxRect &m_box;
+    GestureRecognizer m_gestures = {};
+    uint64_t m_debounceTicks = 0U;
+    uint64_t m_changeTicks = 0U;
+    bool m_pressed = false;
+    bool m_changing = false;
+    bool m_pressEvent = false;
+    bool m_releaseEvent = false;
+};
+
+#endif // INPUT_SOURCE_H_
@@ -0,0 +1,119 @@
+#ifndef LAP_RECORDER_H_
+#define LAP_RECORDER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Lap / split recording
+//
+// A fixed-capacity ring buffer of laps, filled from the button path without
+// touching the heap. Insertion is O(1), and best / worst / mean are updated
+// as each lap comes in, so reading them for a frame costs nothing. The
+// statistics cover every lap since reset, including laps that have already
+// been overwritten in the ring.
+//
+// Times are in timebase ticks, measured on the stopwatch's own clock (i.e.
+// paused time is excluded).
+// ============================================================================
+
+struct Lap {
+    uint64_t splitTicks;   // stopwatch time at the end of the lap
+    uint64_t lapTicks;     // duration of this lap
+    uint32_t number;       // 1-based, keeps counting past CAPACITY
+};
+
+template <uint32_t CAPACITY>
+class LapRecorder {
+    static_assert(CAPACITY > 0U, "LapRecorder needs at least one slot");
+
+public:
+    LapRecorder() { reset(); }
+
+    void reset()
+    {
+        m_next = 0;
+        m_stored = 0;
+        m_total = 0;
+        m_lastSplit = 0;
+        m_sumTicks = 0;
+        m_meanTicks = 0;
+        m_bestTicks = UINT64_MAX;
+        m_worstTicks = 0;
+        m_bestNumber = 0;
+        m_worstNumber = 0;
+    }
+
+    // Records a lap ending at 'splitTicks' and returns it. A split before the
+    // last one (from an input whose event was handled late) is a zero lap.
+    const Lap &record(uint64_t splitTicks)
+    {
+        splitTicks = (splitTicks > m_lastSplit) ? splitTicks : m_lastSplit;
+        const uint64_t lap = splitTicks - m_lastSplit;
+        m_lastSplit = splitTicks;
+
+        m_total++;
+        Lap &slot = m_laps[m_next];
+        slot.splitTicks = splitTicks;
+        slot.lapTicks = lap;
+        slot.number = m_total;
+
+        m_next = (m_next + 1U == CAPACITY) ? 0U : m_next + 1U;
+        if (m_stored < CAPACITY) {
+            m_stored++;
+        }
+
+        m_sumTicks += lap;
+        m_meanTicks = m_sumTicks / m_total;
+        if (lap < m_bestTicks) {
+            m_bestTicks = lap;
+            m_bestNumber = m_total;
+        }
+        if (lap >= m_worstTicks) {
+            m_worstTicks = lap;
+            m_worstNumber = m_total;
+        }
+        return slot;
+    }
+
+    // Laps still held in the ring (at most CAPACITY)
+    uint32_t stored() const { return m_stored; }
+
+    // Laps recorded since reset
+    uint32_t total() const { return m_total; }
+
+    // i-th retained lap, 0 = most recent. Only valid for i < stored().
+    const Lap &recent(uint32_t i) const
+    {
+        uint32_t idx = (m_next + CAPACITY - 1U - i);
+        if (idx >= CAPACITY) {
+            idx -= CAPACITY;
+        }
+        return m_laps[idx];
+    }
+
+    const Lap *latest() const { return (m_stored > 0U) ? &recent(0) : nullptr; }
+
+    uint64_t bestTicks() const { return (m_total > 0U) ? m_bestTicks : 0U; }
+    uint64_t worstTicks() const { return m_worstTicks; }
+    uint32_t bestNumber() const { return m_bestNumber; }
+    uint32_t worstNumber() const { return m_worstNumber; }
+    uint64_t meanTicks() const { return m_meanTicks; }
+
+    static constexpr uint32_t capacity() { return CAPACITY; }
+
+private:
+    Lap m_laps[CAPACITY];
+    uint32_t m_next;
+    uint32_t m_stored;
+    uint32_t m_total;
+    uint64_t m_lastSplit;
+    uint64_t m_sumTicks;
+    uint64_t m_meanTicks;
+    uint64_t m_bestTicks;
+    uint64_t m_worstTicks;
+    uint32_t m_bestNumber;
+    uint32_t m_worstNumber;
+};
+
+#endif // LAP_RECORDER_H_
@@ -0,0 +1,123 @@
+#ifndef LAP_STATS_H_
+#define LAP_STATS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+// ============================================================================
+// Streaming lap statistics
+//
+// Everything the stats page shows, updated in O(1) as each lap comes in and
+// without keeping the laps themselves (the LapRecorder ring only holds the
+// last few):
+//
+//   mean and spread   Welford's running mean and sum of squared deviations,
+//                     which stays accurate when the spread is tiny next to
+//                     the mean (the usual case for laps)
+//   trend             least-squares slope of lap time over lap number, in ms
+//                     per lap, from the same running co-moment; negative
+//                     means the laps are getting faster
+//   histogram         BUCKETS fixed-width buckets; the range is set by the
+//                     first lap (half of it either side), and laps outside
+//                     it go to the end buckets
+//
+// Lap times are in ms. The arithmetic is single precision, which the FPU
+// does in a cycle or two and which holds a lap to the ms up to ~4.6 hours.
+// ============================================================================
+
+template <uint32_t BUCKETS>
+class LapStats {
+    static_assert((BUCKETS >= 2U) && ((BUCKETS % 2U) == 0U),
+                  "LapStats centres the first lap between two halves of buckets");
+
+public:
+    LapStats() { reset(); }
+
+    void reset()
+    {
+        m_count = 0U;
+        m_meanMs = 0.0f;
+        m_m2 = 0.0f;
+        m_cxy = 0.0f;
+        m_lowMs = 0U;
+        m_widthMs = 1U;
+        m_peak = 0U;
+        for (uint32_t i = 0; i < BUCKETS; i++) {
+            m_buckets[i] = 0U;
+        }
+    }
+
+    // Adds a lap and returns the bucket it was counted in.
+    uint32_t add(uint32_t lapMs)
+    {
+        if (m_count == 0U) {
+            m_widthMs = (lapMs + BUCKETS - 1U) / BUCKETS;
+            m_widthMs = (m_widthMs > 0U) ? m_widthMs : 1U;
+            const uint32_t half = (BUCKETS / 2U) * m_widthMs;
+            m_lowMs = (lapMs > half) ? (lapMs - half) : 0U;
+        }
+
+        // Welford, with the lap number as x for the co-moment: lap n is n/2
+        // past the mean of laps 1..n-1
+        m_count++;
+        const float n = static_cast<float>(m_count);
+        const float y = static_cast<float>(lapMs);
+        const float dx = n / 2.0f;
+        const float dy = y - m_meanMs;
+        m_meanMs += dy / n;
+        const float dyNew = y - m_meanMs;
+        m_m2 += dy * dyNew;
+        m_cxy += dx * dyNew;
+
+        const uint32_t offset = (lapMs > m_lowMs) ? (lapMs - m_lowMs) / m_widthMs : 0U;
+        const uint32_t bucket = (offset < BUCKETS) ? offset : (BUCKETS - 1U);
+        if (m_buckets[bucket] < UINT16_MAX) {
+            m_buckets[bucket]++;
+        }
+        m_peak = (m_buckets[bucket] > m_peak) ? m_buckets[bucket] : m_peak;
+        return bucket;
+    }
+
+    uint32_t count() const { return m_count; }
+    float meanMs() const { return m_meanMs; }
+
+    // Sample standard deviation; 0 below two laps
+    float stdDevMs() const
+    {
+        return (m_count > 1U) ? sqrtf(m_m2 / static_cast<float>(m_count - 1U)) : 0.0f;
+    }
+
+    // ms per lap; 0 below two laps. Lap numbers 1..n have a sum of squared
+    // deviations of n(n^2 - 1)/12.
+    float trendMsPerLap() const
+    {
+        if (m_count < 2U) {
+            return 0.0f;
+        }
+        const float n = static_cast<float>(m_count);
+        return m_cxy / (n * (n * n - 1.0f) / 12.0f);
+    }
+
+    uint16_t bucket(uint32_t i) const { return m_buckets[i]; }
+    const uint16_t *buckets() const { return m_buckets; }
+    uint16_t peak() const { return m_peak; }
+
+    // The histogram's range: bucket i starts at lowMs() + i * widthMs()
+    uint32_t lowMs() const { return m_lowMs; }
+    uint32_t widthMs() const { return m_widthMs; }
+
+    static constexpr uint32_t bucketCount() { return BUCKETS; }
+
+private:
+    uint32_t m_count;
+    float m_meanMs;
+    float m_m2;       // sum of squared deviations from the mean
+    float m_cxy;      // co-moment of lap number and lap time
+    uint32_t m_lowMs;
+    uint32_t m_widthMs;
+    uint16_t m_peak;
+    uint16_t m_buckets[BUCKETS];
+};
+
+#endif // LAP_STATS_H_
@@ -0,0 +1,252 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "latencyBench.h"
+#include "criticalSection.h"
+#include "edgeButton.h"
+#include "telemetry.h"
+#include "timebase.h"
+
+// After the last edge the replay waits out the longest gesture window and
+// a few frames before it counts as done
+static constexpr uint32_t REPLAY_SETTLE_MS = 1500U;
+
+// State changes waiting for their pixels; more in flight are not measured
+static constexpr uint32_t MAX_PENDING = 8U;
+
+const ReplayEdge LATENCY_TRACE[] = {
+    // S1 click: start, applied on the press
+    {0U, 0U, true}, {1U, 0U, false}, {2U, 0U, true}, {110U, 0U, false},
+    // S2 clicks: laps, applied on the press
+    {1000U, 1U, true}, {1003U, 1U, false}, {1004U, 1U, true}, {1090U, 1U, false},
+    {1600U, 1U, true}, {1680U, 1U, false},
+    // S1 double click: the first press stops, the second makes it a lap
+    {2200U, 0U, true}, {2280U, 0U, false}, {2380U, 0U, true}, {2450U, 0U, false},
+    // S1 click: stop, then S2 click: reset
+    {3200U, 0U, true}, {3202U, 0U, false}, {3203U, 0U, true}, {3300U, 0U, false},
+    {4200U, 1U, true}, {4290U, 1U, false},
+    // S1 click: start, then S2 held: lap on the press, stop and reset on the hold
+    {5000U, 0U, true}, {5090U, 0U, false},
+    {6000U, 1U, true}, {6001U, 1U, false}, {6002U, 1U, true}, {7000U, 1U, false},
+    // Start, stop and reset once more
+    {7500U, 0U, true}, {7580U, 0U, false},
+    {8500U, 0U, true}, {8570U, 0U, false},
+    {9000U, 1U, true}, {9100U, 1U, false},
+};
+const uint32_t LATENCY_TRACE_LENGTH = sizeof(LATENCY_TRACE) / sizeof(LATENCY_TRACE[0]);
+
+struct SampleSet {
+    uint32_t count;
+    uint32_t us[LATENCY_MAX_SAMPLES];
+};
+
+enum PendingStage : uint8_t {
+    PENDING_FREE,
+    PENDING_WAIT_FRAME,   // changed, no frame has read it yet
+    PENDING_DRAWING,      // the current frame includes it
+    PENDING_FLUSHING      // its frame is on its way to the panel
+};
+
+struct Pending {
+    uint64_t edgeTicks;
+    PendingStage stage;
+};
+
+// Written by the handlers, the renderer and the flush-done interrupt, and
+// only with interrupts masked
+static SampleSet sSamples[LATENCY_METRICS];
+static Pending sPending[MAX_PENDING];
+
+// Replay state, owned by the heartbeat hook while sRunning
+static const ReplayEdge *sTrace = nullptr;
+static uint32_t sLength = 0;
+static EdgeButton *const *sInputs = nullptr;
+static uint32_t sInputCount = 0;
+static uint32_t sNext = 0;
+static uint64_t sStartTicks = 0;
+static volatile bool sRunning = false;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+// Nearest-rank percentile of sorted samples
+static uint32_t percentile(const uint32_t *sorted, uint32_t count, uint32_t pct)
+{
+    if (count == 0U) {
+        return 0U;
+    }
+    const uint32_t rank = (pct * count + 99U) / 100U;
+    return sorted[(rank == 0U) ? 0U : (rank - 1U)];
+}
+
+// Timebase heartbeat (interrupt context): replays every edge that is due
+static void replayTick(uint64_t nowTicks)
+{
+    if (!sRunning) {
+        return;
+    }
+    const uint64_t elapsed = nowTicks - sStartTicks;
+    while ((sNext < sLength) && (elapsed >= timebaseMsToTicks(sTrace[sNext].atMs))) {
+        const ReplayEdge &edge = sTrace[sNext++];
+        if (edge.input < sInputCount) {
+            sInputs[edge.input]->replayEdge(edge.pressed, nowTicks);
+        }
+    }
+
+    const uint32_t endMs = (sLength > 0U) ? sTrace[sLength - 1U].atMs : 0U;
+    if ((sNext == sLength) && (elapsed >= timebaseMsToTicks(endMs + REPLAY_SETTLE_MS))) {
+        for (uint32_t i = 0; i < sInputCount; i++) {
+            sInputs[i]->setReplay(false);
+        }
+        sRunning = false;
+    }
+}
+
+// ============================================================================
+// Replay
+// ============================================================================
+void latencyReplayInit()
+{
+    timebaseAddTickHook(replayTick);
+}
+
+bool latencyReplayStart(const ReplayEdge *trace, uint32_t length,
+                        EdgeButton *const *inputs, uint32_t inputCount)
+{
+    if (sRunning) {
+        return false;
+    }
+    {
+        CriticalSection cs;
+        for (uint32_t m = 0; m < LATENCY_METRICS; m++) {
+            sSamples[m].count = 0U;
+        }
+        for (uint32_t i = 0; i < MAX_PENDING; i++) {
+            sPending[i].stage = PENDING_FREE;
+        }
+    }
+
+    sTrace = trace;
+    sLength = length;
+    sInputs = inputs;
+    sInputCount = inputCount;
+    sNext = 0U;
+    for (uint32_t i = 0; i < inputCount; i++) {
+        inputs[i]->setReplay(true);
+    }
+    sStartTicks = timebaseNow();
+    sRunning = true;
+    return true;
+}
+
+bool latencyReplayRunning()
+{
+    return sRunning;
+}
+
+// ============================================================================
+// Results
+// ============================================================================
+LatencySummary latencySummary(LatencyMetric metric)
+{
+    SampleSet set;
+    {
+        CriticalSection cs;
+        set = sSamples[metric];
+    }
+
+    // Insertion sort: a few dozen samples, once per report
+    for (uint32_t i = 1; i < set.count; i++) {
+        const uint32_t v = set.us[i];
+        uint32_t j = i;
+        for (; (j > 0U) && (set.us[j - 1U] > v); j--) {
+            set.us[j] = set.us[j - 1U];
+        }
+        set.us[j] = v;
+    }
+
+    LatencySummary s;
+    s.count = set.count;
+    s.p50Us = percentile(set.us, set.count, 50U);
+    s.p90Us = percentile(set.us, set.count, 90U);
+    s.p99Us = percentile(set.us, set.count, 99U);
+    s.maxUs = (set.count > 0U) ? set.us[set.count - 1U] : 0U;
+    return s;
+}
+
+void latencyReport()
+{
+    const uint64_t now = timebaseNow();
+    for (uint32_t m = 0; m < LATENCY_METRICS; m++) {
+        const LatencySummary s = latencySummary(static_cast<LatencyMetric>(m));
+        const uint32_t values[LATENCY_STATISTICS] = {s.count, s.p50Us, s.p90Us, s.p99Us, s.maxUs};
+        for (uint32_t k = 0; k < LATENCY_STATISTICS; k++) {
+            telemetryPost(TELEM_LATENCY, (m << 4) | k, now, values[k]);
+        }
+    }
+}
+
+// ============================================================================
+// Probes
+// ============================================================================
+#if LATENCY_PROBE_ENABLE
+
+static void addSample(LatencyMetric metric, uint64_t ticks)
+{
+    SampleSet &set = sSamples[metric];
+    if (set.count < LATENCY_MAX_SAMPLES) {
+        const uint64_t us = timebaseTicksToUs(ticks);
+        set.us[set.count++] = (us > 0xFFFFFFFFU) ? 0xFFFFFFFFU : static_cast<uint32_t>(us);
+    }
+}
+
+// Moves every pending change at stage 'from' on; PENDING_FREE completes it
+// at 'nowTicks'. Interrupts masked.
+static void advance(PendingStage from, PendingStage to, uint64_t nowTicks)
+{
+    for (uint32_t i = 0; i < MAX_PENDING; i++) {
+        Pending &p = sPending[i];
+        if (p.stage != from) {
+            continue;
+        }
+        if (to == PENDING_FREE) {
+            addSample(LATENCY_PIXELS, nowTicks - p.edgeTicks);
+        }
+        p.stage = to;
+    }
+}
+
+void latencyStateChanged(uint64_t edgeTicks)
+{
+    const uint64_t now = timebaseNow();
+    CriticalSection cs;
+    addSample(LATENCY_STATE, now - edgeTicks);
+    for (uint32_t i = 0; i < MAX_PENDING; i++) {
+        if (sPending[i].stage == PENDING_FREE) {
+            sPending[i] = {edgeTicks, PENDING_WAIT_FRAME};
+            break;
+        }
+    }
+}
+
+void latencyFrameBegin()
+{
+    CriticalSection cs;
+    advance(PENDING_WAIT_FRAME, PENDING_DRAWING, 0U);
+}
+
+void latencyFrameEnd(bool flushing)
+{
+    const uint64_t now = timebaseNow();
+    CriticalSection cs;
+    advance(PENDING_DRAWING, flushing ? PENDING_FLUSHING : PENDING_FREE, now);
+}
+
+void latencyFlushDone()
+{
+    const uint64_t now = timebaseNow();
+    CriticalSection cs;
+    advance(PENDING_FLUSHING, PENDING_FREE, now);
+}
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef LATENCY_BENCH_H_
+#define LATENCY_BENCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+class EdgeButton;
+
+// ============================================================================
+// End-to-end input latency benchmark
+//
+// Replays a recorded sequence of button edges through the real input path
+// (edge capture, heartbeat debounce and gestures, the input handlers, the
+// renderer and the LCD flush) and measures, for every edge whose action
+// changed something:
+//   - LATENCY_STATE:  from the edge's timestamp to the handler applying it
+//   - LATENCY_PIXELS: from the edge's timestamp until the flush that put
+//                     the result on the panel has finished
+// Both run from the timestamp the handler is given, i.e. the first press of
+// its gesture, so a gesture that only applies once it is complete (a long
+// press) counts that wait too.
+//
+// The replay pushes each edge into its EdgeButton at the recorded time from
+// a heartbeat hook, exactly where the port interrupt would, and the real
+// pins are ignored until it ends. The same code runs on the target and in
+// the host simulation (sim/), where the results are deterministic and gated
+// against a baseline.
+//
+// latencyReport() sends the percentiles as TELEM_LATENCY telemetry frames.
+// The probes cost a few stores per state change and per frame; build with
+// LATENCY_PROBE_ENABLE=0 to compile them away.
+// ============================================================================
+
+#ifndef LATENCY_PROBE_ENABLE
+#define LATENCY_PROBE_ENABLE 1
+#endif
+
+// One recorded edge: 'input' indexes the inputs given to latencyReplayStart
+struct ReplayEdge {
+    uint32_t atMs;    // since the start of the replay
+    uint8_t input;
+    bool pressed;
+};
+
+// S1/S2 session of clicks, double clicks and a long press, with contact
+// bounce; input 0 is S1, input 1 is S2
+extern const ReplayEdge LATENCY_TRACE[];
+extern const uint32_t LATENCY_TRACE_LENGTH;
+
+enum LatencyMetric : uint8_t {
+    LATENCY_STATE  = 0,
+    LATENCY_PIXELS = 1,
+    LATENCY_METRICS
+};
+
+// What a TELEM_LATENCY frame carries, in its channel byte as
+// metric * 16 + statistic; the argument is the count or microseconds
+enum LatencyStatistic : uint8_t {
+    LATENCY_COUNT = 0,
+    LATENCY_P50   = 1,
+    LATENCY_P90   = 2,
+    LATENCY_P99   = 3,
+    LATENCY_MAX   = 4,
+    LATENCY_STATISTICS
+};
+
+struct LatencySummary {
+    uint32_t count;
+    uint32_t p50Us, p90Us, p99Us, maxUs;
+};
+
+// Samples kept per metric; later ones are dropped
+static constexpr uint32_t LATENCY_MAX_SAMPLES = 64U;
+
+// Registers the replay's heartbeat hook. Call after timebaseInit().
+void latencyReplayInit();
+
+// Clears the samples and replays 'trace' into 'inputs', starting now. The
+// edges must be in time order and leave every input released. Returns false
+// if a replay is already running.
+bool latencyReplayStart(const ReplayEdge *trace, uint32_t length,
+                        EdgeButton *const *inputs, uint32_t inputCount);
+
+// True until the last edge has been replayed and its results are shown
+bool latencyReplayRunning();
+
+LatencySummary latencySummary(LatencyMetric metric);
+
+// Posts every statistic of both metrics as TELEM_LATENCY frames
+void latencyReport();
+
+#if LATENCY_PROBE_ENABLE
+
+// An input handler applied the gesture that started at 'edgeTicks'
+void latencyStateChanged(uint64_t edgeTicks);
+
+// A frame starts reading the state; changes made before it are in it
+void latencyFrameBegin();
+
+// The frame is drawn. 'flushing': its pixels are still on their way to the
+// panel and latencyFlushDone() follows; otherwise they are already there.
+void latencyFrameEnd(bool flushing);
+
+// Everything flushed so far is on the panel (interrupt context)
+void latencyFlushDone();
+
+#else
+
+static inline void latencyStateChanged(uint64_t) {}
+static inline void latencyFrameBegin() {}
+static inline void latencyFrameEnd(bool) {}
+static inline void latencyFlushDone() {}
+
+#endif
+
+#endif // LATENCY_BENCH_H_
@@ -0,0 +1,142 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "driverlib/gpio.h"
+#include "inc/hw_memmap.h"
+#include "Crystalfontz128x128_ST7735.h"
+#include "HAL_EK_TM4C1294XL_Crystalfontz128x128_ST7735.h"
+}
+
+#include "lcdBoot.h"
+#include "lcdFramebuffer.h"
+#include "timebase.h"
+
+// The BoosterPack 1 site wires the LCD's reset to PH3; override for other sites.
+#ifndef LCD_RESET_PORT
+#define LCD_RESET_PORT GPIO_PORTH_BASE
+#endif
+#ifndef LCD_RESET_PIN
+#define LCD_RESET_PIN GPIO_PIN_3
+#endif
+
+// ST7735 commands used at power-up
+static constexpr uint8_t ST_SLPOUT = 0x11U;
+static constexpr uint8_t ST_NORON  = 0x13U;
+static constexpr uint8_t ST_GAMSET = 0x26U;
+static constexpr uint8_t ST_DISPON = 0x29U;
+static constexpr uint8_t ST_COLMOD = 0x3AU;
+static constexpr uint8_t ST_SETPWCTR = 0xB1U;   // power control, reference driver's name
+static constexpr uint8_t ST_SETSTBA  = 0xC0U;   // standby/source option, likewise
+static constexpr uint8_t NO_COMMAND = 0xFFU;   // releases the reset line instead
+
+struct PanelStep {
+    uint8_t command;
+    uint8_t argCount;
+    uint8_t args[2];
+    uint16_t waitMs;    // before the next step
+};
+
+// The datasheet's minimums: reset low >= 10 us, 120 ms from releasing it to
+// the first command, and 120 ms after sleep-out before the next one
+static constexpr uint32_t RESET_LOW_MS = 1U;
+static const PanelStep POWER_UP[] = {
+    {NO_COMMAND, 0U, {0U, 0U}, 120U},
+    {ST_SLPOUT,  0U, {0U, 0U}, 120U},
+    {ST_GAMSET,  1U, {0x04U, 0U}, 0U},   // gamma curve 3, as the reference driver
+    {ST_SETPWCTR, 2U, {0x0AU, 0x14U}, 0U},
+    {ST_SETSTBA,  2U, {0x0AU, 0x00U}, 0U},
+    {ST_COLMOD,  1U, {0x05U, 0U}, 0U},   // 16 bpp
+    {ST_NORON,   0U, {0U, 0U}, 0U},
+};
+static constexpr uint32_t POWER_UP_STEPS = sizeof(POWER_UP) / sizeof(POWER_UP[0]);
+
+enum BootState : uint8_t {
+    BOOT_IDLE,        // lcdBootStart() not called yet
+    BOOT_SEQUENCE,    // running POWER_UP
+    BOOT_PIXELS,      // configured, display still off
+    BOOT_DONE
+};
+
+static BootState sState = BOOT_IDLE;
+static uint32_t sStep = 0;
+static uint64_t sDueTicks = 0;
+static uint8_t sOrientation = 0;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+static void sendStep(const PanelStep &step)
+{
+    if (step.command == NO_COMMAND) {
+        GPIOPinWrite(LCD_RESET_PORT, LCD_RESET_PIN, LCD_RESET_PIN);
+        return;
+    }
+    HAL_LCD_writeCommand(step.command);
+    for (uint32_t i = 0; i < step.argCount; i++) {
+        HAL_LCD_writeData(step.args[i]);
+    }
+}
+
+// Whole ms from now until 'ticks', at least 1 while it is still ahead
+static uint32_t msUntil(uint64_t ticks)
+{
+    const uint64_t now = timebaseNow();
+    if (ticks <= now) {
+        return 0U;
+    }
+    return static_cast<uint32_t>(timebaseTicksToMs(ticks - now + timebaseMsToTicks(1U) - 1U));
+}
+
+// ============================================================================
+// Power-up
+// ============================================================================
+void lcdBootStart(uint8_t orientation)
+{
+    HAL_LCD_PortInit();
+    HAL_LCD_SpiInit();
+    GPIOPinWrite(LCD_RESET_PORT, LCD_RESET_PIN, 0U);
+
+    sOrientation = orientation;
+    sStep = 0U;
+    sDueTicks = timebaseNow() + timebaseMsToTicks(RESET_LOW_MS);
+    sState = BOOT_SEQUENCE;
+}
+
+uint32_t lcdBootService()
+{
+    while (sState == BOOT_SEQUENCE) {
+        const uint32_t waitMs = msUntil(sDueTicks);
+        if (waitMs != 0U) {
+            return waitMs;
+        }
+        const PanelStep &step = POWER_UP[sStep++];
+        sendStep(step);
+        sDueTicks = timebaseNow() + timebaseMsToTicks(step.waitMs);
+        if (sStep == POWER_UP_STEPS) {
+            // Also sets the driver's window offsets for this orientation
+            Crystalfontz128x128_SetOrientation(sOrientation);
+            sState = BOOT_PIXELS;
+            return 1U;   // the caller draws the first frame now
+        }
+    }
+    if (sState == BOOT_PIXELS) {
+        // That frame has to be on the panel before it is shown
+        if (lcdFramebufferBusy()) {
+            return 1U;
+        }
+        HAL_LCD_writeCommand(ST_DISPON);
+        sState = BOOT_DONE;
+    }
+    return 0U;
+}
+
+bool lcdBootPixelsReady()
+{
+    return (sState == BOOT_PIXELS) || (sState == BOOT_DONE);
+}
+
+bool lcdBootDone()
+{
+    return sState == BOOT_DONE;
+}
@@ -0,0 +1,41 @@
+#ifndef LCD_BOOT_H_
+#define LCD_BOOT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Non-blocking ST7735 power-up
+//
+// Crystalfontz128x128_Init() waits out the controller's reset and sleep-out
+// times (and clears the panel over blocking SPI) before it returns, some
+// 400 ms in which nothing else can run. Here the same commands, with the same
+// arguments and in the same order, are a list of steps with the wait after
+// each one. lcdBootStart() only sets up the pins
+// and the bus and asserts reset; lcdBootService() sends whatever is due and
+// says how long until the next step, so the main loop runs the power-up in
+// between handling input.
+//
+// Once the controller takes pixels the first frame can be drawn and flushed
+// (through the framebuffer's uDMA stream); the display is switched on after
+// that flush has finished, so the panel never shows the random RAM contents
+// it wakes up with.
+// ============================================================================
+
+// Sets up the LCD's pins and SPI bus and holds the controller in reset.
+// Returns at once; 'orientation' is an LCD_ORIENTATION_* value.
+void lcdBootStart(uint8_t orientation);
+
+// Runs the steps that are due. Returns the ms until the next one, or 0 once
+// the display is on. Call from the main loop, and again after the first
+// frame has been drawn: the display goes on at the first call that finds
+// its flush finished.
+uint32_t lcdBootService();
+
+// The controller is awake and configured: pixels can be drawn and flushed
+bool lcdBootPixelsReady();
+
+// The display is on
+bool lcdBootDone();
+
+#endif // LCD_BOOT_H_
@@ -0,0 +1,492 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+extern "C" {
+#include "driverlib/interrupt.h"
+#include "driverlib/ssi.h"
+#include "driverlib/udma.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_ssi.h"
+#include "Crystalfontz128x128_ST7735.h"
+#include "HAL_EK_TM4C1294XL_Crystalfontz128x128_ST7735.h"
+}
+
+#include "dmaControl.h"
+#include "lcdFramebuffer.h"
+
+// The BoosterPack 1 site routes the LCD to SSI2; override for other sites.
+#ifndef LCD_SSI_BASE
+#define LCD_SSI_BASE SSI2_BASE
+#endif
+#ifndef LCD_SSI_INT
+#define LCD_SSI_INT INT_SSI2
+#endif
+#ifndef LCD_DMA_CHANNEL
+#define LCD_DMA_CHANNEL UDMA_CH13_SSI2TX
+#endif
+
+static constexpr uint32_t FB_ROW_BYTES   = LCD_FB_WIDTH * 2U;
+static constexpr uint32_t DMA_MAX_ITEMS  = 1024U;   // uDMA basic-mode limit
+static constexpr int32_t  NO_ROWS        = -1;
+
+// Pixels are stored byte-swapped so memory order matches the wire order
+// (RGB565, high byte first) and DMA can stream the buffer unchanged.
+static uint16_t sFrame[LCD_FB_WIDTH * LCD_FB_HEIGHT];
+
+// Screen canvas; its dirty rows are touched from the main loop only
+static LcdCanvas sScreen = {sFrame, LCD_FB_WIDTH, LCD_FB_HEIGHT, NO_ROWS, NO_ROWS};
+
+// Rows waiting for the current transfer to finish (guarded by masking IRQs)
+static int32_t sQueuedY0 = NO_ROWS;
+static int32_t sQueuedY1 = NO_ROWS;
+
+// Transfer in flight (ISR-owned while busy)
+static volatile bool sBusy = false;
+static const uint8_t *sTxNext = nullptr;
+static uint32_t sTxRemaining = 0;
+static void (*sFlushCallback)() = nullptr;
+
+// Window being covered by span fills (main loop only)
+struct SpanWindow {
+    int32_t x, y, w;
+    int32_t col, row;
+};
+static SpanWindow sSpan = {0, 0, 0, 0, 0};
+
+// ============================================================================
+// Helpers
+// ============================================================================
+static inline uint16_t toPanelOrder(uint32_t rgb565)
+{
+    return static_cast<uint16_t>(((rgb565 & 0xFFU) << 8) | ((rgb565 >> 8) & 0xFFU));
+}
+
+static inline uint32_t translate24(uint32_t value)
+{
+    return ((value & 0x00F80000U) >> 8) |
+           ((value & 0x0000FC00U) >> 5) |
+           ((value & 0x000000F8U) >> 3);
+}
+
+static inline void markDirty(LcdCanvas &c, int32_t y0, int32_t y1)
+{
+    if (c.dirtyY0 == NO_ROWS) {
+        c.dirtyY0 = y0;
+        c.dirtyY1 = y1;
+        return;
+    }
+    if (y0 < c.dirtyY0) {
+        c.dirtyY0 = y0;
+    }
+    if (y1 > c.dirtyY1) {
+        c.dirtyY1 = y1;
+    }
+}
+
+static inline LcdCanvas &canvasOf(void *displayData)
+{
+    return *static_cast<LcdCanvas *>(displayData);
+}
+
+static void startDmaChunk()
+{
+    uint32_t count = (sTxRemaining > DMA_MAX_ITEMS) ? DMA_MAX_ITEMS : sTxRemaining;
+
+    uDMAChannelTransferSet(LCD_DMA_CHANNEL | UDMA_PRI_SELECT, UDMA_MODE_BASIC,
+                           const_cast<uint8_t *>(sTxNext),
+                           reinterpret_cast<void *>(LCD_SSI_BASE + SSI_O_DR),
+                           count);
+    sTxNext += count;
+    sTxRemaining -= count;
+    uDMAChannelEnable(LCD_DMA_CHANNEL);
+}
+
+// Runs from thread context with the SSI interrupt masked, or from the ISR.
+static void startStrip(int32_t y0, int32_t y1)
+{
+    sBusy = true;
+
+    Crystalfontz128x128_SetDrawFrame(0, static_cast<uint16_t>(y0),
+                                     LCD_FB_WIDTH - 1U, static_cast<uint16_t>(y1));
+    HAL_LCD_writeCommand(CM_RAMWR);
+
+    // The first byte goes through the HAL so it leaves D/C in data mode; the
+    // rest of the strip is streamed straight from the buffer.
+    const uint8_t *strip = reinterpret_cast<const uint8_t *>(&sFrame[y0 * LCD_FB_WIDTH]);
+    HAL_LCD_writeData(strip[0]);
+
+    sTxNext = strip + 1;
+    sTxRemaining = static_cast<uint32_t>(y1 - y0 + 1) * FB_ROW_BYTES - 1U;
+    startDmaChunk();
+}
+
+static void lcdSsiISR()
+{
+    SSIIntClear(LCD_SSI_BASE, SSI_DMATX);
+
+    if (uDMAChannelIsEnabled(LCD_DMA_CHANNEL)) {
+        return;
+    }
+    if (sTxRemaining > 0U) {
+        startDmaChunk();
+        return;
+    }
+
+    // DMA is done once the last byte is in the FIFO; let the shifter drain
+    // (at most 8 bytes) before touching D/C again.
+    while (SSIBusy(LCD_SSI_BASE)) {
+    }
+
+    if (sQueuedY0 != NO_ROWS) {
+        const int32_t y0 = sQueuedY0;
+        const int32_t y1 = sQueuedY1;
+        sQueuedY0 = NO_ROWS;
+        sQueuedY1 = NO_ROWS;
+        startStrip(y0, y1);
+        return;
+    }
+
+    sBusy = false;
+    if (sFlushCallback != nullptr) {
+        sFlushCallback();
+    }
+}
+
+// ============================================================================
+// GrLib display driver callbacks (pvDisplayData is the target LcdCanvas)
+// ============================================================================
+static void fbPixelDraw(void *data, int32_t x, int32_t y, uint32_t value)
+{
+    LcdCanvas &c = canvasOf(data);
+    if ((x < 0) || (y < 0) || (x >= c.width) || (y >= c.height)) {
+        return;
+    }
+    c.pixels[y * c.width + x] = toPanelOrder(value);
+    markDirty(c, y, y);
+}
+
+static void fbPixelDrawMultiple(void *data, int32_t x, int32_t y, int32_t x0,
+                                int32_t count, int32_t bpp,
+                                const uint8_t *pixels, const uint8_t *palette)
+{
+    LcdCanvas &c = canvasOf(data);
+    if ((y < 0) || (y >= c.height)) {
+        return;
+    }
+    uint16_t *row = &c.pixels[y * c.width];
+    markDirty(c, y, y);
+
+    // Same palette conventions as the TI reference drivers: 1 bpp palettes
+    // are pre-translated, 4/8 bpp palettes hold 24-bit RGB triplets.
+    switch (bpp & 0xFF) {
+    case 1:
+        while (count > 0) {
+            const uint32_t byte = *pixels++;
+            for (; (x0 < 8) && (count > 0); x0++, count--, x++) {
+                if ((x >= 0) && (x < c.width)) {
+                    const uint32_t idx = (byte >> (7 - x0)) & 1U;
+                    row[x] = toPanelOrder(reinterpret_cast<const uint32_t *>(palette)[idx]);
+                }
+            }
+            x0 = 0;
+        }
+        break;
+
+    case 4:
+        while (count > 0) {
+            const uint32_t nibble = (x0 & 1) ? (*pixels++ & 0x0FU) : (*pixels >> 4);
+            const uint8_t *rgb = palette + nibble * 3U;
+            if ((x >= 0) && (x < c.width)) {
+                row[x] = toPanelOrder(translate24((rgb[2] << 16) | (rgb[1] << 8) | rgb[0]));
+            }
+            x0 ^= 1;
+            x++;
+            count--;
+        }
+        break;
+
+    case 8:
+        while (count > 0) {
+            const uint8_t *rgb = palette + (*pixels++) * 3U;
+            if ((x >= 0) && (x < c.width)) {
+                row[x] = toPanelOrder(translate24((rgb[2] << 16) | (rgb[1] << 8) | rgb[0]));
+            }
+            x++;
+            count--;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+static void fbLineDrawH(void *data, int32_t x1, int32_t x2, int32_t y, uint32_t value)
+{
+    LcdCanvas &c = canvasOf(data);
+    if (x1 > x2) {
+        const int32_t t = x1; x1 = x2; x2 = t;
+    }
+    if ((y < 0) || (y >= c.height)) {
+        return;
+    }
+    if (x1 < 0) {
+        x1 = 0;
+    }
+    if (x2 >= c.width) {
+        x2 = c.width - 1;
+    }
+
+    const uint16_t pixel = toPanelOrder(value);
+    uint16_t *p = &c.pixels[y * c.width + x1];
+    for (int32_t x = x1; x <= x2; x++) {
+        *p++ = pixel;
+    }
+    markDirty(c, y, y);
+}
+
+static void fbLineDrawV(void *data, int32_t x, int32_t y1, int32_t y2, uint32_t value)
+{
+    LcdCanvas &c = canvasOf(data);
+    if (y1 > y2) {
+        const int32_t t = y1; y1 = y2; y2 = t;
+    }
+    if ((x < 0) || (x >= c.width)) {
+        return;
+    }
+    if (y1 < 0) {
+        y1 = 0;
+    }
+    if (y2 >= c.height) {
+        y2 = c.height - 1;
+    }
+
+    const uint16_t pixel = toPanelOrder(value);
+    for (int32_t y = y1; y <= y2; y++) {
+        c.pixels[y * c.width + x] = pixel;
+    }
+    markDirty(c, y1, y2);
+}
+
+static void fbRectFill(void *data, const tRectangle *rect, uint32_t value)
+{
+    for (int32_t y = rect->i16YMin; y <= rect->i16YMax; y++) {
+        fbLineDrawH(data, rect->i16XMin, rect->i16XMax, y, value);
+    }
+}
+
+static uint32_t fbColorTranslate(void *, uint32_t value)
+{
+    return translate24(value);
+}
+
+static void fbFlush(void *data)
+{
+    // Off-screen canvases have nothing to flush
+    if (&canvasOf(data) == &sScreen) {
+        lcdFramebufferFlush();
+    }
+}
+
+const tDisplay g_sLcdFramebuffer = {
+    sizeof(tDisplay),
+    &sScreen,
+    LCD_FB_WIDTH,
+    LCD_FB_HEIGHT,
+    fbPixelDraw,
+    fbPixelDrawMultiple,
+    fbLineDrawH,
+    fbLineDrawV,
+    fbRectFill,
+    fbColorTranslate,
+    fbFlush
+};
+
+void lcdCanvasDisplayInit(tDisplay &display, LcdCanvas &canvas,
+                          uint16_t *pixels, int32_t width, int32_t height)
+{
+    canvas.pixels = pixels;
+    canvas.width = width;
+    canvas.height = height;
+    canvas.dirtyY0 = NO_ROWS;
+    canvas.dirtyY1 = NO_ROWS;
+
+    display = g_sLcdFramebuffer;
+    display.pvDisplayData = &canvas;
+    display.ui16Width = static_cast<uint16_t>(width);
+    display.ui16Height = static_cast<uint16_t>(height);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+void lcdFramebufferInit()
+{
+    dmaControlInit();
+
+    uDMAChannelAssign(LCD_DMA_CHANNEL);
+    uDMAChannelAttributeDisable(LCD_DMA_CHANNEL, UDMA_ATTR_ALL);
+    uDMAChannelAttributeEnable(LCD_DMA_CHANNEL, UDMA_ATTR_USEBURST);
+
+    // 8-bit items, FIFO is 8 deep and requests DMA when half empty
+    uDMAChannelControlSet(LCD_DMA_CHANNEL | UDMA_PRI_SELECT,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE |
+                          UDMA_ARB_4);
+
+    SSIDMAEnable(LCD_SSI_BASE, SSI_DMA_TX);
+    SSIIntRegister(LCD_SSI_BASE, lcdSsiISR);
+    SSIIntEnable(LCD_SSI_BASE, SSI_DMATX);
+    IntPrioritySet(LCD_SSI_INT, 0x80);   // below timekeeping and input
+
+    memset(sFrame, 0, sizeof(sFrame));
+    sScreen.dirtyY0 = NO_ROWS;
+    sScreen.dirtyY1 = NO_ROWS;
+}
+
+void lcdFramebufferFlush()
+{
+    if (sScreen.dirtyY0 == NO_ROWS) {
+        return;
+    }
+
+    const int32_t y0 = sScreen.dirtyY0;
+    const int32_t y1 = sScreen.dirtyY1;
+    sScreen.dirtyY0 = NO_ROWS;
+    sScreen.dirtyY1 = NO_ROWS;
+
+    IntDisable(LCD_SSI_INT);
+    if (sBusy) {
+        if ((sQueuedY0 == NO_ROWS) || (y0 < sQueuedY0)) {
+            sQueuedY0 = y0;
+        }
+        if ((sQueuedY1 == NO_ROWS) || (y1 > sQueuedY1)) {
+            sQueuedY1 = y1;
+        }
+    } else {
+        startStrip(y0, y1);
+    }
+    IntEnable(LCD_SSI_INT);
+}
+
+bool lcdFramebufferBusy()
+{
+    return sBusy;
+}
+
+void lcdFramebufferSetFlushCallback(void (*callback)())
+{
+    sFlushCallback = callback;
+}
+
+void lcdFramebufferBlit(int32_t x, int32_t y, int32_t w, int32_t h,
+                        const uint16_t *pixels)
+{
+    for (int32_t row = 0; row < h; row++, pixels += w) {
+        const int32_t py = y + row;
+        if ((py < 0) || (py >= static_cast<int32_t>(LCD_FB_HEIGHT))) {
+            continue;
+        }
+        int32_t sx = 0;
+        int32_t dx = x;
+        int32_t n = w;
+        if (dx < 0) {
+            sx = -dx;
+            n += dx;
+            dx = 0;
+        }
+        if (dx + n > static_cast<int32_t>(LCD_FB_WIDTH)) {
+            n = static_cast<int32_t>(LCD_FB_WIDTH) - dx;
+        }
+        if (n <= 0) {
+            continue;
+        }
+        memcpy(&sFrame[py * LCD_FB_WIDTH + dx], pixels + sx,
+               static_cast<size_t>(n) * sizeof(uint16_t));
+        markDirty(sScreen, py, py);
+    }
+}
+
+void lcdDirectBlit(int32_t x, int32_t y, int32_t w, int32_t h,
+                   const uint16_t *pixels)
+{
+    if ((w <= 0) || (h <= 0)) {
+        return;
+    }
+    Crystalfontz128x128_SetDrawFrame(static_cast<uint16_t>(x), static_cast<uint16_t>(y),
+                                     static_cast<uint16_t>(x + w - 1),
+                                     static_cast<uint16_t>(y + h - 1));
+    HAL_LCD_writeCommand(CM_RAMWR);
+
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(pixels);
+    const uint32_t count = static_cast<uint32_t>(w * h) * 2U;
+    for (uint32_t i = 0; i < count; i++) {
+        HAL_LCD_writeData(bytes[i]);
+    }
+}
+
+void lcdFramebufferSpanBegin(int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    sSpan = {x, y, w, 0, 0};
+    const int32_t y0 = (y > 0) ? y : 0;
+    const int32_t y1 = (y + h <= static_cast<int32_t>(LCD_FB_HEIGHT)) ? (y + h - 1)
+                                                                     : (static_cast<int32_t>(LCD_FB_HEIGHT) - 1);
+    if ((w > 0) && (y0 <= y1)) {
+        markDirty(sScreen, y0, y1);
+    }
+}
+
+void lcdFramebufferSpanFill(uint16_t pixel, uint32_t count)
+{
+    while ((count > 0U) && (sSpan.w > 0)) {
+        const uint32_t left = static_cast<uint32_t>(sSpan.w - sSpan.col);
+        const uint32_t n = (count < left) ? count : left;
+        const int32_t py = sSpan.y + sSpan.row;
+        if ((py >= 0) && (py < static_cast<int32_t>(LCD_FB_HEIGHT))) {
+            for (uint32_t i = 0; i < n; i++) {
+                const int32_t px = sSpan.x + sSpan.col + static_cast<int32_t>(i);
+                if ((px >= 0) && (px < static_cast<int32_t>(LCD_FB_WIDTH))) {
+                    sFrame[py * static_cast<int32_t>(LCD_FB_WIDTH) + px] = pixel;
+                }
+            }
+        }
+        count -= n;
+        sSpan.col += static_cast<int32_t>(n);
+        if (sSpan.col == sSpan.w) {
+            sSpan.col = 0;
+            sSpan.row++;
+        }
+    }
+}
+
+void lcdDirectSpanBegin(int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    if ((w <= 0) || (h <= 0)) {
+        return;
+    }
+    Crystalfontz128x128_SetDrawFrame(static_cast<uint16_t>(x), static_cast<uint16_t>(y),
+                                     static_cast<uint16_t>(x + w - 1),
+                                     static_cast<uint16_t>(y + h - 1));
+    HAL_LCD_writeCommand(CM_RAMWR);
+}
+
+void lcdDirectSpanFill(uint16_t pixel, uint32_t count)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&pixel);
+    for (uint32_t i = 0; i < count; i++) {
+        HAL_LCD_writeData(bytes[0]);
+        HAL_LCD_writeData(bytes[1]);
+    }
+}
+
+void lcdSetSysClock(uint32_t sysClock)
+{
+    const uint32_t bitRate = (LCD_SPI_HZ < (sysClock / 2U)) ? LCD_SPI_HZ : (sysClock / 2U);
+    while (SSIBusy(LCD_SSI_BASE)) {
+    }
+    SSIDisable(LCD_SSI_BASE);
+    SSIConfigSetExpClk(LCD_SSI_BASE, sysClock, SSI_FRF_MOTO_MODE_0, SSI_MODE_MASTER,
+                       bitRate, 8U);
+    SSIEnable(LCD_SSI_BASE);
+}
@@ -0,0 +1,120 @@
+#ifndef LCD_FRAMEBUFFER_H_
+#define LCD_FRAMEBUFFER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "grlib/grlib.h"
+}
+
+// ============================================================================
+// SRAM framebuffer with background uDMA flush
+//
+// g_sLcdFramebuffer is a GrLib display whose primitives only write to a
+// 128x128 RGB565 buffer in SRAM and widen a dirty row range. GrFlush() hands
+// the dirty rows to the uDMA controller, which streams them to the ST7735
+// over SSI while the CPU keeps running.
+//
+// There is a single buffer, flushed as full-width horizontal strips. Rows
+// redrawn while a strip is still in flight are marked dirty again and go out
+// with the next flush, so the panel always converges on the buffer contents
+// without needing a second 32 KB copy.
+//
+// Set LCD_USE_FRAMEBUFFER to 0 to draw straight to g_sCrystalfontz128x128.
+// ============================================================================
+
+#ifndef LCD_USE_FRAMEBUFFER
+#define LCD_USE_FRAMEBUFFER 1
+#endif
+
+static constexpr uint32_t LCD_FB_WIDTH  = 128U;
+static constexpr uint32_t LCD_FB_HEIGHT = 128U;
+
+// SPI bit rate the LCD HAL sets up. An SSI master runs at no more than half
+// the system clock, so lower clocks get a slower bus.
+static constexpr uint32_t LCD_SPI_HZ = 15000000U;
+
+extern const tDisplay g_sLcdFramebuffer;
+
+// A 16 bpp drawing surface in panel byte order. g_sLcdFramebuffer draws into
+// the screen canvas; lcdCanvasDisplayInit() builds a GrLib display over any
+// other buffer, e.g. for pre-rendering glyphs off-screen.
+struct LcdCanvas {
+    uint16_t *pixels;
+    int32_t width;
+    int32_t height;
+    int32_t dirtyY0;
+    int32_t dirtyY1;
+};
+
+void lcdCanvasDisplayInit(tDisplay &display, LcdCanvas &canvas,
+                          uint16_t *pixels, int32_t width, int32_t height);
+
+// Call once the panel is up (see lcdBoot.h); claims the LCD's SSI TX DMA
+// channel.
+void lcdFramebufferInit();
+
+// Starts streaming the dirty rows (same as GrFlush on g_sLcdFramebuffer).
+// Never blocks: if a transfer is already running the rows are queued and sent
+// from the DMA completion interrupt.
+void lcdFramebufferFlush();
+
+// True while a strip is being streamed to the panel.
+bool lcdFramebufferBusy();
+
+// Called from interrupt context when the last queued strip has been sent.
+void lcdFramebufferSetFlushCallback(void (*callback)());
+
+// Copies a native-order (big-endian RGB565) image into the buffer and marks
+// its rows dirty. 'pixels' holds w*h entries, row-major.
+void lcdFramebufferBlit(int32_t x, int32_t y, int32_t w, int32_t h,
+                        const uint16_t *pixels);
+
+// Same, but written straight to the panel with blocking SPI writes.
+void lcdDirectBlit(int32_t x, int32_t y, int32_t w, int32_t h,
+                   const uint16_t *pixels);
+
+// Run-length output: opens a w x h window, which the following span fills
+// cover in row-major order with runs of one pixel value (panel byte order).
+// Nothing is staged: the framebuffer path writes each run into the buffer,
+// the direct path clocks it out over SPI as it comes.
+void lcdFramebufferSpanBegin(int32_t x, int32_t y, int32_t w, int32_t h);
+void lcdFramebufferSpanFill(uint16_t pixel, uint32_t count);
+void lcdDirectSpanBegin(int32_t x, int32_t y, int32_t w, int32_t h);
+void lcdDirectSpanFill(uint16_t pixel, uint32_t count);
+
+static inline void lcdSpanBegin(int32_t x, int32_t y, int32_t w, int32_t h)
+{
+#if LCD_USE_FRAMEBUFFER
+    lcdFramebufferSpanBegin(x, y, w, h);
+#else
+    lcdDirectSpanBegin(x, y, w, h);
+#endif
+}
+
+static inline void lcdSpanFill(uint16_t pixel, uint32_t count)
+{
+#if LCD_USE_FRAMEBUFFER
+    lcdFramebufferSpanFill(pixel, count);
+#else
+    lcdDirectSpanFill(pixel, count);
+#endif
+}
+
+// Re-derives the LCD's SPI bit rate after a system clock change. Call with
+// no strip in flight (lcdFramebufferBusy() false).
+void lcdSetSysClock(uint32_t sysClock);
+
+// Blits through whichever path LCD_USE_FRAMEBUFFER selects.
+static inline void lcdBlit(int32_t x, int32_t y, int32_t w, int32_t h,
+                           const uint16_t *pixels)
+{
+#if LCD_USE_FRAMEBUFFER
+    lcdFramebufferBlit(x, y, w, h, pixels);
+#else
+    lcdDirectBlit(x, y, w, h, pixels);
+#endif
+}
+
+#endif // LCD_FRAMEBUFFER_H_
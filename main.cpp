@@ -1,8 +1,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include <stdio.h>
-#include <string>
+#include <string.h>
 
 extern "C" {
 #include "driverlib/fpu.h"
@@ -18,258 +17,920 @@ extern "C" {
 #include "button.h"
 #include "timerLib.h"
 #include "elapsedTime.h"
+#include "retainedUi.h"
+#include "staticUi.h"
+#include "screenLayout.h"
+#include "widgetTable.h"
+#include "timebase.h"
+#include "lcdFramebuffer.h"
+#include "lcdBoot.h"
+#include "digitCache.h"
+#include "timeFormat.h"
+#include "clockFields.h"
+#include "scheduler.h"
+#include "edgeButton.h"
+#include "lapRecorder.h"
+#include "lapStats.h"
+#include "profiler.h"
+#include "frameGovernor.h"
+#include "stopwatch.h"
+#include "telemetry.h"
+#include "resultLog.h"
+#include "powerManager.h"
+#include "criticalSection.h"
+#include "latencyBench.h"
+#include "resumeSnapshot.h"
+
+// Capture S1/S2 with GPIO edge interrupts (timestamped) instead of polling
+#ifndef BUTTON_USE_EDGE_CAPTURE
+#define BUTTON_USE_EDGE_CAPTURE 1
+#endif
+
+// Run input, result logging and rendering as prioritized FreeRTOS tasks
+// instead of the superloop (see "Task model" below)
+#ifndef APP_USE_RTOS
+#define APP_USE_RTOS 0
+#endif
+
+// Draw the time readout with the large RLE digits from flash instead of the
+// 6x8 font's cells cached in SRAM
+#ifndef TIME_USE_LARGE_DIGITS
+#define TIME_USE_LARGE_DIGITS 1
+#endif
+
+// Benchmark build: replay LATENCY_TRACE into S1/S2 at boot and send the
+// latency percentiles over telemetry once it has run (see latencyBench.h)
+#ifndef APP_LATENCY_BENCH
+#define APP_LATENCY_BENCH 0
+#endif
+
+#if APP_LATENCY_BENCH && !BUTTON_USE_EDGE_CAPTURE
+#error "the latency replay feeds EdgeButton; build with BUTTON_USE_EDGE_CAPTURE=1"
+#endif
+
+// The host simulation's bench (sim/bench.cpp) runs the replay itself
+#define APP_HAS_LATENCY_REPLAY (BUTTON_USE_EDGE_CAPTURE && (APP_LATENCY_BENCH || SIM_BUILD))
+
+// Press the on-screen buttons through a resistive touch overlay. Its driver
+// provides touchOverlayRead(); so far only the host simulation has one.
+#ifndef APP_USE_TOUCH
+#define APP_USE_TOUCH SIM_BUILD
+#endif
+
+#if APP_USE_RTOS
+#include "FreeRTOS.h"
+#include "task.h"
+extern "C" {
+#include "driverlib/cpu.h"
+#include "driverlib/systick.h"
+}
+#endif
 
 // ===== Global configuration =====
-static constexpr uint32_t BUTTON_TICK_MS     = 20U;
-static constexpr uint32_t DISPLAY_REFRESH_MS = 50U;
+static constexpr uint32_t SYSTEM_CLOCK_HZ    = 120000000U;
+static constexpr uint32_t LOW_POWER_CLOCK_HZ = 12000000U;   // 480 MHz VCO / 40
+static constexpr uint32_t POWER_IDLE_MS      = 2000U;   // quiet time before slowing down
+static constexpr uint32_t POWER_POLL_MS      = 10U;
+static constexpr uint32_t BUTTON_TICK_MS     = 20U;   // main loop drains input events
+static constexpr uint32_t BUTTON_DEBOUNCE_MS = 30U;
+static constexpr uint32_t LONG_PRESS_MS      = 800U;   // S2 held: reset
+static constexpr uint32_t MULTI_CLICK_MS     = 250U;   // S1 twice: lap
+static constexpr uint32_t DISPLAY_TARGET_FPS = 60U;
+static constexpr uint32_t DISPLAY_CPU_BUDGET_PCT = 50U;
+static constexpr uint32_t LAP_CAPACITY       = 32U;
+static constexpr uint32_t LAP_HISTOGRAM_BUCKETS = 16U;
+static constexpr uint32_t STATS_BARS_PER_FRAME = 4U;   // histogram bars repainted per frame
+static constexpr int32_t PAGE_WIPE_ROWS      = 16;   // rows cleared per frame on a page switch
+static constexpr uint32_t DEBUG_POLL_MS      = 100U;
+static constexpr uint32_t RESULT_LOG_SERVICE_MS = 5U;   // one EEPROM word per run
+static constexpr uint32_t RESULT_LOG_RESTORE_SCAN = 64U;
+static constexpr uint32_t WATCHDOG_TIMEOUT_MS = 1000U;   // main loop stuck this long: reset
 
 uint32_t gSystemClock = 0;
-volatile uint32_t gStopwatchMs = 0;
-volatile bool gRunning = false;
+
+// Every position and the fonts, fixed at compile time (see screenLayout.h)
+#if TIME_USE_LARGE_DIGITS
+using Layout = StopwatchLayout<LCD_FB_WIDTH, LCD_FB_HEIGHT, FontFixed6x8, FontLargeDigits>;
+#else
+using Layout = StopwatchLayout<LCD_FB_WIDTH, LCD_FB_HEIGHT, FontFixed6x8>;
+#endif
+using Font = Layout::Font;
+using DigitFont = Layout::DigitFont;
+static_assert(Layout::TIME_CHARS == TIME_TEXT_LEN, "the time box holds HH:MM:SS.mmm");
+using StatsLayout = LapStatsLayout<LCD_FB_WIDTH, LCD_FB_HEIGHT, FontFixed6x8, LAP_HISTOGRAM_BUCKETS>;
+
+// Channel shown on screen; S1/S2 act on it, USR_SW1 pages to the next one.
+// Every channel also has its own GPIO start/stop input (see stopwatch.h).
+static uint32_t gShownChannel = 0;
+static uint32_t gStopwatchMs = 0;   // snapshot taken at the start of each frame
+
+// What each channel counts (see stopwatch.h): CH7 is a 3 minute countdown,
+// CH8 eight rounds of 30 s work and 10 s rest
+static constexpr StopwatchProgram CHANNEL_PROGRAMS[STOPWATCH_CHANNELS] = {
+    STOPWATCH_PROGRAM_COUNT_UP, STOPWATCH_PROGRAM_COUNT_UP,
+    STOPWATCH_PROGRAM_COUNT_UP, STOPWATCH_PROGRAM_COUNT_UP,
+    STOPWATCH_PROGRAM_COUNT_UP, STOPWATCH_PROGRAM_COUNT_UP,
+    {STOPWATCH_COUNTDOWN, 180000U, 0U, 0U},
+    {STOPWATCH_INTERVAL, 30000U, 10000U, 8U},
+};
+
+// Shown time as carried HH:MM:SS.mmm fields; frames step it forward and only
+// the fields that rolled over are reformatted and redrawn
+static ClockCounter gClock;
+static uint32_t gClockChannel = STOPWATCH_CHANNELS;   // none yet: first frame sets it
+static char gTimeText[TIME_TEXT_LEN + 1U];
+
+// S2 records a lap while running and resets while stopped. Each channel's
+// laps also feed its statistics page.
+static LapRecorder<LAP_CAPACITY> gLaps[STOPWATCH_CHANNELS];
+static LapStats<LAP_HISTOGRAM_BUCKETS> gLapStats[STOPWATCH_CHANNELS];
+
+// Holding USR_SW1 switches between the stopwatch and the shown channel's
+// lap statistics. The input side asks for a page; frames switch to it by
+// clearing the body PAGE_WIPE_ROWS at a time and then repainting the new
+// page's widgets, so no single frame does more than a strip's worth.
+enum ScreenPage : uint8_t {
+    PAGE_STOPWATCH,
+    PAGE_LAP_STATS
+};
+static volatile ScreenPage gRequestedPage = PAGE_STOPWATCH;
+static ScreenPage gShownPage = PAGE_STOPWATCH;
+static int32_t gWipeY = Layout::BODY.y + Layout::BODY.h;   // next row to clear; past the body: done
+
+// The on-screen buttons are painted and can be touched: the stopwatch page
+// is up (read by the touch keys in the heartbeat)
+static volatile bool gButtonsShown = false;
 
 // ============================================================================
-// STRUCT: Simple GUI Button (for drawing)
+// Event scheduling (the core sleeps in WFI between events)
 // ============================================================================
-struct MyButton {
-    int x, y, w, h;
-    const char* label;
-    bool pressed;
+#if APP_USE_RTOS
+static TaskHandle_t gRenderTask = nullptr;
+#else
+static EventScheduler<5> gScheduler;
+static int32_t gDisplayEvent = -1;
+static int32_t gPowerEvent = -1;
+#endif
+static volatile bool gInputSeen = false;   // serviceButtons handled an event since servicePower
+static tContext gContext;
+
+// One frame scheduler: the governor sets the display event's period from
+// the measured render and flush cost.
+static FrameGovernor gFrameGovernor(DISPLAY_TARGET_FPS, DISPLAY_CPU_BUDGET_PCT);
+static uint32_t gFlushStartCycles = 0;
+static volatile uint32_t gLastFlushCycles = 0;
+
+// Until the panel takes pixels, the display event runs its power-up steps
+// instead of frames, each when it is due (see lcdBoot.h)
+static uint32_t gPanelWaitMs = 0;
+static bool gScreenDrawn = false;
+
+// Boot milestones, in system clock cycles since profilerInit(); sent as
+// TELEM_BOOT frames once the display is on
+enum BootStage : uint8_t {
+    BOOT_INPUT_READY = 0,   // input interrupts and the heartbeat are live
+    BOOT_DISPLAY_ON  = 1,   // the first frame is on the panel and showing
+    BOOT_STAGES
 };
+static uint32_t gBootCycles[BOOT_STAGES];
+
+// ============================================================================
+// Retained widgets (only repainted when their content changes)
+// ============================================================================
+static TextWidget wState(Layout::STATE);
+static TextWidget wLap(Layout::LAP);
+
+// HH:MM:SS.mmm readout, drawn per character from pre-rendered glyphs
+#if TIME_USE_LARGE_DIGITS
+using TimeGlyphs = RleDigits<DigitFont::CELL_W, DigitFont::CELL_H>;
+static const TimeGlyphs gDigitsRunning(DigitFont::font(), ClrYellow, ClrBlack);
+static const TimeGlyphs gDigitsStopped(DigitFont::font(), ClrOlive, ClrBlack);
+#else
+using TimeGlyphs = DigitCache<DigitFont::CELL_W, DigitFont::CELL_H>;
+static TimeGlyphs gDigitsRunning;
+static TimeGlyphs gDigitsStopped;
+#endif
+static DigitReadout<TimeGlyphs, TIME_TEXT_LEN> wTime(Layout::TIME);
 
-// One on-screen button: Play / Pause
-static MyButton btnStart = {0, 80, 50, 28, "PLAY", false};
-static MyButton guiBtnReset = {60, 80, 50, 28, "RESET", false};
+// Lap statistics page
+static TextWidget wStatsHeader(StatsLayout::HEADER);
+static TextWidget wStatsMean(StatsLayout::MEAN);
+static TextWidget wStatsSpread(StatsLayout::SPREAD);
+static TextWidget wStatsTrend(StatsLayout::TREND);
+static TextWidget wStatsRange(StatsLayout::RANGE);
+static BarGraphWidget wHistogram(StatsLayout::HISTOGRAM, LAP_HISTOGRAM_BUCKETS,
+                                 StatsLayout::BAR_W, StatsLayout::BAR_PITCH, ClrCyan);
 
 // ============================================================================
 // Hardware button
 // ============================================================================
-static Button btnPlayPause(S1);  // S1 → Play/Pause
-static Button btnReset(S2);  // S2 → second button
+#if BUTTON_USE_EDGE_CAPTURE
+static EdgeButton btnPlayPause(EDGE_S1);  // S1 → Play/Pause
+static EdgeButton btnReset(EDGE_S2);  // S2 → second button
+#else
+static Button keyPlayPause(S1);
+static Button keyReset(S2);
+static PolledInput<Button> btnPlayPause(keyPlayPause);  // S1 → Play/Pause
+static PolledInput<Button> btnReset(keyReset);  // S2 → second button
+#endif
+static EdgeButton btnChannel(EDGE_USR_SW1);  // USR_SW1 → next channel
+static EdgeButton btnGate(EDGE_GATE_PL4);  // photogate → start, then laps
 
 // ============================================================================
 // Function prototypes
 // ============================================================================
+static void initializeSystem();
 static void initializeDisplay(tContext &context);
+static bool bringUpDisplay();
+static uint32_t displayPeriodMs();
 static void configureTimer(Timer &timer);
 static void setupButtons();
-static void drawStopwatchScreen(tContext &context, uint32_t currentMs, bool running);
-static void drawButton(tContext &context, const MyButton &btn);
+static void restoreResults();
+static bool drawStopwatchScreen(tContext &context, uint32_t channel,
+                                uint32_t changedFields, bool running, const StopwatchView &view);
+static bool drawLapStatsScreen(tContext &context, uint32_t channel);
+static bool wipeBody(tContext &context);
+
+static void serviceButtons();
+static void servicePower();
+static void serviceDisplay();
+static void serviceDebug();
+static void serviceResultLog();
+static void requestFrame();
+#if APP_USE_RTOS
+static void startTasks();
+#endif
 
-static void onPlayPauseClick();
+static void onPlayPausePress(uint64_t atTicks);
+static void onPlayPauseClicks(uint64_t atTicks, uint32_t clicks);
+static void onPlayPauseLongPress(uint64_t atTicks);
 static void onPlayPauseRelease();
-static void onResetClick();
+static void onResetClick(uint64_t atTicks);
 static void onResetRelease();
+static void onResetLongPress(uint64_t atTicks);
+static void recordLap(uint32_t channel, uint64_t atTicks);
+static void resetShownChannel(uint64_t atTicks);
+static void onChannelClicks(uint64_t atTicks, uint32_t clicks);
+static void onChannelLongPress(uint64_t atTicks);
+static void onGatePress(uint64_t atTicks);
+#if LCD_USE_FRAMEBUFFER
+static void onFlushComplete();
+#endif
+static void sampleButtons(uint64_t nowTicks);
+static void onSystemClock(uint32_t sysClock);
+#if APP_HAS_LATENCY_REPLAY
+static bool startLatencyReplay();
+#endif
+
+// ============================================================================
+// On-screen buttons and what drives them
+// ============================================================================
+enum ScreenButton : uint32_t {
+    BTN_START,    // Play / Pause
+    BTN_RESET,    // Reset / Lap
+    SCREEN_BUTTON_COUNT
+};
+
+static constexpr ButtonSpec SCREEN_BUTTONS[SCREEN_BUTTON_COUNT] = {
+    {Layout::START_BUTTON, "PLAY"},
+    {Layout::RESET_BUTTON, "RESET"},
+};
+
+static ButtonPanel<SCREEN_BUTTON_COUNT> gButtons(SCREEN_BUTTONS);
+
+#if APP_USE_TOUCH
+bool touchOverlayRead(TouchPoint &point);   // the overlay's driver
+
+// Touching a button acts exactly like its hardware twin, as long as the
+// buttons are on screen
+static bool touchShownButtons(TouchPoint &point)
+{
+    return gButtonsShown && touchOverlayRead(point);
+}
+
+static TouchOverlay gTouch(touchShownButtons);
+static TouchKey touchStart(gTouch, SCREEN_BUTTONS[BTN_START].box);
+static TouchKey touchReset(gTouch, SCREEN_BUTTONS[BTN_RESET].box);
+#endif
+
+using Inputs = InputTable<
+    InputBinding<decltype(btnPlayPause), &btnPlayPause, BTN_START,
+                 onPlayPausePress, onPlayPauseRelease, onPlayPauseLongPress, onPlayPauseClicks>,
+    InputBinding<decltype(btnReset), &btnReset, BTN_RESET,
+                 onResetClick, onResetRelease, onResetLongPress>,
+    InputBinding<EdgeButton, &btnChannel, NO_WIDGET,
+                 inputNoAction, inputNoRelease, onChannelLongPress, onChannelClicks>,
+#if APP_USE_TOUCH
+    InputBinding<TouchKey, &touchStart, BTN_START,
+                 onPlayPausePress, onPlayPauseRelease, onPlayPauseLongPress, onPlayPauseClicks>,
+    InputBinding<TouchKey, &touchReset, BTN_RESET,
+                 onResetClick, onResetRelease, onResetLongPress>,
+#endif
+    InputBinding<EdgeButton, &btnGate, NO_WIDGET, onGatePress>>;
+
+// Debounced transitions, from the heartbeat interrupt to serviceButtons()
+static InputEventQueue<32> gInputEvents;
 
 // ============================================================================
 // MAIN PROGRAM
 // ============================================================================
 int main(void)
+{
+    initializeSystem();
+
+#if APP_USE_RTOS
+    startTasks();   // does not return
+#else
+    while (true) {
+        if (!gScheduler.dispatch()) {
+            gScheduler.idle();
+        }
+    }
+#endif
+}
+
+// Everything up to the main loop; the host simulation (sim/) runs the same
+// sequence and then drives the loop itself.
+static void initializeSystem()
 {
     IntMasterDisable();
     FPUEnable();
     FPULazyStackingEnable();
 
-    gSystemClock = SysCtlClockFreqSet(SYSCTL_XTAL_25MHZ | SYSCTL_OSC_MAIN |SYSCTL_USE_PLL | SYSCTL_CFG_VCO_480,120000000);
-
-    tContext sContext;
-    initializeDisplay(sContext);
+    gSystemClock = SysCtlClockFreqSet(SYSCTL_XTAL_25MHZ | SYSCTL_OSC_MAIN |SYSCTL_USE_PLL | SYSCTL_CFG_VCO_480, SYSTEM_CLOCK_HZ);
+    profilerInit(gSystemClock);
 
-    Timer timer;
+    // Timing and input first: channels that were running when the board
+    // reset carry on from the snapshot (without one, the stopped times come
+    // back from the result log), and presses are taken from the moment
+    // interrupts are enabled below. The LCD only gets its pins and reset
+    // here; it powers up from the display event (bringUpDisplay).
+    static Timer timer;
     configureTimer(timer);
-
-    elapsedMillis buttonTick(timer);
-    elapsedMillis displayTick(timer);
-    elapsedMillis stopwatchTick(timer);
+    telemetryInit();
+    const bool logged = resultLogInit();
+    const bool resumed = snapshotInit(gSystemClock) && snapshotRestore(timebaseNow());
+    if (logged && !resumed) {
+        restoreResults();
+    }
 
     setupButtons();
+    snapshotStart();
+    powerInit({SYSTEM_CLOCK_HZ, LOW_POWER_CLOCK_HZ, POWER_IDLE_MS, onSystemClock});
+    gFrameGovernor.setClock(gSystemClock);
+    lcdBootStart(LCD_ORIENTATION_UP);
+
+#if !APP_USE_RTOS
+    static elapsedMillis buttonTick(timer);
+    static elapsedMillis displayTick(timer);
+    static elapsedMillis debugTick(timer);
+    static elapsedMillis resultLogTick(timer);
+    static elapsedMillis powerTick(timer);
+
+    // Power right after input, so a wake-up switches before the next frame
+    gScheduler.add(buttonTick, BUTTON_TICK_MS, serviceButtons);
+    gPowerEvent = gScheduler.add(powerTick, POWER_POLL_MS, servicePower);
+    gDisplayEvent = gScheduler.add(displayTick, gFrameGovernor.periodMs(), serviceDisplay);
+    gScheduler.trigger(gDisplayEvent);
+    gScheduler.add(debugTick, DEBUG_POLL_MS, serviceDebug);
+    gScheduler.add(resultLogTick, RESULT_LOG_SERVICE_MS, serviceResultLog);
+#endif
+
+    watchdogStart(WATCHDOG_TIMEOUT_MS);
     IntMasterEnable();
+    gBootCycles[BOOT_INPUT_READY] = profilerCycles();
 
-    // Timer stuff
-    uint32_t lastDisplayedSec = static_cast<uint32_t>(-1);
-    uint32_t lastDisplayedMin = static_cast<uint32_t>(-1);
-    uint32_t lastDisplayedHr = static_cast<uint32_t>(-1);
-    uint32_t lastDisplayedMS = static_cast<uint32_t>(-1);
+#if APP_LATENCY_BENCH
+    startLatencyReplay();
+#endif
+}
 
-    bool lastRunning = !gRunning;
+// ============================================================================
+// Scheduled events
+// ============================================================================
+static void serviceButtons()
+{
+    // Show button feedback and state changes on the next frame instead of
+    // waiting out the frame period
+#if APP_USE_RTOS
+    // The render task owns the panel and shows the pressed states itself
+    const bool handled = Inputs::handleAll(gInputEvents);
+    if (handled) {
+        gInputSeen = true;
+        requestFrame();   // which also runs servicePower first
+    }
+#else
+    // The stats page leaves the buttons alone, so their pressed states wait
+    // until the stopwatch page repaints them anyway
+    const bool handled = Inputs::dispatch(gInputEvents, gButtons);
+    if (handled || (gButtonsShown && gButtons.isDirty())) {
+        requestFrame();
+    }
+    if (handled) {
+        gInputSeen = true;
+        gScheduler.trigger(gPowerEvent);
+    }
+#endif
+}
 
-    while (true) {
-        // --- Poll physical ` ---
-        if (buttonTick >= BUTTON_TICK_MS) {
-            btnPlayPause.tick();
-            btnReset.tick();
-            buttonTick = 0;
-        }
+// Full clock while a channel is timing or the user is doing something; the
+// low clock after POWER_IDLE_MS of neither. Edges are timestamped by the
+// timebase, so input handled at the low clock loses no accuracy. Runs from
+// the main loop (the render task in the task build), so it also feeds the
+// watchdog.
+static void servicePower()
+{
+    watchdogFeed();
+    const bool active = gInputSeen || (stopwatchRunningMask() != 0U);
+    gInputSeen = false;
+    powerUpdate(timebaseNow(), active);
+}
 
-        // --- Handle Play/Pause button ---
-        if (btnPlayPause.wasPressed()) {
-            btnStart.pressed = true;
-            onPlayPauseClick();
-        }
-        if (btnPlayPause.wasReleased()) {
-            btnStart.pressed = false;
-            onPlayPauseRelease();
-        }
+// One frame. Fields that did not change cost nothing (retained widgets and
+// the digit readout skip them), so HH:MM only redraw on rollover while the
+// millisecond digits update at whatever rate the governor allows.
+static void serviceDisplay()
+{
+    if (!lcdBootDone() && !bringUpDisplay()) {
+#if !APP_USE_RTOS
+        gScheduler.setPeriod(gDisplayEvent, displayPeriodMs());
+#endif
+        return;
+    }
+    const uint32_t start = profilerCycles();
 
-        if (btnReset.wasPressed()) {
-            guiBtnReset.pressed = true;
-            onResetClick();
-        }
-        if (btnReset.wasReleased()) {
-            guiBtnReset.pressed = false;
-            onResetRelease();
-        }
+    // Input may page while a frame is drawn (it preempts rendering in the
+    // task build), so the frame sticks to the channel it started with
+    latencyFrameBegin();
+    const uint32_t channel = gShownChannel;
+    const Stopwatch shown(channel);
+    const bool running = shown.running();
+    const StopwatchView view = shown.viewAt(timebaseNow());
+    gStopwatchMs = view.shownMs;
+#if APP_USE_RTOS
+    Inputs::showLevels(gButtons);
+#endif
 
-        // --- Stopwatch logic ---
-        if (gRunning) {
-            uint32_t delta = stopwatchTick;
-            if (delta > 0U) {
-                gStopwatchMs += delta;
-                stopwatchTick = 0;
-            }
+    // A page switch first clears the body, a strip per frame
+    const ScreenPage page = gRequestedPage;
+    if ((page != gShownPage) && (gWipeY >= Layout::BODY.y + Layout::BODY.h)) {
+        gWipeY = Layout::BODY.y;
+        gButtonsShown = false;
+    }
+    gShownPage = page;
+
+    bool painted;
+    if (gWipeY < Layout::BODY.y + Layout::BODY.h) {
+        painted = wipeBody(gContext);
+    } else if (page == PAGE_LAP_STATS) {
+        painted = drawLapStatsScreen(gContext, channel);
+    } else {
+        // Paging to another channel is a jump; otherwise step the carried
+        // fields (down for a countdown, and up again when an interval phase
+        // changes)
+        uint32_t changed;
+        if (gClockChannel != channel) {
+            gClockChannel = channel;
+            changed = gClock.set(gStopwatchMs);
         } else {
-            stopwatchTick = 0;
+            changed = gClock.moveTo(gStopwatchMs);
         }
-
-        // --- Update screen if needed ---
-        // Seconds
-        uint32_t currentSec = gStopwatchMs / 1000U;
-        uint32_t currentMin = gStopwatchMs / 60000U;
-        unint32_t currentHr = gStopwatchMs / 3600000U;
-        uint32_t currentMS = gStopwatchMs;
-
-        if ((currentSec != lastDisplayedSec) ||
-            (gRunning != lastRunning) ||
-            (displayTick >= DISPLAY_REFRESH_MS)) {
-
-            drawStopwatchScreen(sContext, currentSec, currentMin, currentHr, currentMS, gRunning);
-            drawStopwatchScreen(sContext, currentSec, gRunning);
-            drawButton(sContext, btnStart);
-            drawButton(sContext, guiBtnReset);
-
-            #ifdef GrFlush
-            GrFlush(&sContext);
-            #endif
-
-            lastDisplayedSec = currentSec;
-            lastRunning = gRunning;
-            displayTick = 0;
+        painted = drawStopwatchScreen(gContext, channel, changed, running, view);
+    }
+    if (painted) {
+#if LCD_USE_FRAMEBUFFER
+        if (!lcdFramebufferBusy()) {
+            gFlushStartCycles = profilerCycles();
         }
+#endif
+        #ifdef GrFlush
+        GrFlush(&gContext);
+        #endif
+    }
+    // With the framebuffer, the next flush-done interrupt is at the end of
+    // a chain that includes this frame's rows
+    latencyFrameEnd(painted && LCD_USE_FRAMEBUFFER);
 
-        // Mins
-        if ((currentMin != lastDisplayedMin) ||
-            (gRunning != lastRunning) ||
-            (displayTick >= DISPLAY_REFRESH_MS)) {
-
-                lastDisplayedMin = currentMin;
-                lastRunning = gRunning;
-                displayTick = 0;
-            }
-
-        // Hours
-        if ((currentHr != lastDisplayedHr) ||
-            (gRunning != lastRunning) ||
-            (displayTick >= DISPLAY_REFRESH_MS)) {
+    gFrameGovernor.frameDone(profilerCycles() - start, gLastFlushCycles);
+#if !APP_USE_RTOS
+    gScheduler.setPeriod(gDisplayEvent, displayPeriodMs());
+#endif
+}
 
-                lastDisplayedHr = currentHr;
-                lastRunning = gRunning;
-                displayTick = 0;
-            }
+// The panel's power-up steps that are due, and the static screen once it
+// takes pixels. Returns true when frames can be drawn.
+static bool bringUpDisplay()
+{
+    gPanelWaitMs = lcdBootService();
+    if (lcdBootDone()) {
+        gBootCycles[BOOT_DISPLAY_ON] = profilerCycles();
+        const uint64_t now = timebaseNow();
+        const uint32_t cyclesPerUs = SYSTEM_CLOCK_HZ / 1000000U;
+        for (uint32_t stage = 0; stage < BOOT_STAGES; stage++) {
+            telemetryPost(TELEM_BOOT, stage, now, gBootCycles[stage] / cyclesPerUs);
+        }
+    }
+    if (!lcdBootPixelsReady()) {
+        return false;
+    }
+    if (!gScreenDrawn) {
+        initializeDisplay(gContext);
+        gScreenDrawn = true;
+    }
+    return true;
+}
 
-        // Millisecond
-        unint32_t currentMS = gStopwatchMs / 1U;
-        if ((currentMS != lastDisplayedMS) ||
-            (gRunning != lastRunning) ||
-            (displayTick >= DISPLAY_REFRESH_MS)) {
+// Frames at the governor's rate; before that, back when the next power-up
+// step is due
+static uint32_t displayPeriodMs()
+{
+    return lcdBootPixelsReady() ? gFrameGovernor.periodMs() : gPanelWaitMs;
+}
 
-                lastDisplayedMS = currentMS;
-                lastRunning = gRunning;
-                displayTick = 0;
-            }
+// 'p' over UART0 dumps the profiling table, 'r' clears it
+static void serviceDebug()
+{
+    profilerPollUart();
+#if APP_LATENCY_BENCH
+    static bool reported = false;
+    if (!reported && !latencyReplayRunning()) {
+        latencyReport();
+        reported = true;
     }
+#endif
+}
+
+// Trickles queued results into the EEPROM without waiting on it
+static void serviceResultLog()
+{
+    resultLogService();
 }
 
 // ============================================================================
 // System configuration
 // ============================================================================
 
+// Once the panel takes pixels (lcdBootPixelsReady)
 static void initializeDisplay(tContext &context)
 {
-    Crystalfontz128x128_Init();
-    Crystalfontz128x128_SetOrientation(LCD_ORIENTATION_UP);
+#if LCD_USE_FRAMEBUFFER
+    // Draw into SRAM; GrFlush streams the dirty rows out via uDMA
+    lcdFramebufferInit();
+    lcdFramebufferSetFlushCallback(onFlushComplete);
+    GrContextInit(&context, &g_sLcdFramebuffer);
+#else
     GrContextInit(&context, &g_sCrystalfontz128x128);
-    GrContextFontSet(&context, &g_sFontFixed6x8);
+#endif
+    GrContextFontSet(&context, Font::font());
 
+    // The only full-screen clear; after this every widget repaints its own
+    // box. The title never changes and comes pre-rasterized from flash.
     tRectangle full = {0, 0, 127, 127};
     GrContextForegroundSet(&context, ClrBlack);
     GrRectFill(&context, &full);
+    staticUiBlit(STATIC_UI_TITLE);
+#ifdef GrFlush
+    // Frames drawn while this is on its way chain onto it, and the flush
+    // cost the governor sees runs from here
+    gFlushStartCycles = profilerCycles();
+    GrFlush(&context);
+#endif
+
+#if !TIME_USE_LARGE_DIGITS
+    gDigitsRunning.render(DigitFont::font(), ClrYellow, ClrBlack);
+    gDigitsStopped.render(DigitFont::font(), ClrOlive, ClrBlack);
+#endif
+
+    wState.invalidate();
+    wLap.invalidate();
+    wTime.invalidate();
+    gButtons.invalidate();
+    gButtonsShown = true;
 }
 
 static void configureTimer(Timer &timer)
 {
     timer.begin(gSystemClock, TIMER0_BASE);
+    timebaseInit(gSystemClock, TIMER1_BASE, TIMER2_BASE);
+    stopwatchChannelsInit(STOPWATCH_INPUTS_PORTM);
+    for (uint32_t ch = 0; ch < STOPWATCH_CHANNELS; ch++) {
+        Stopwatch(ch).setProgram(CHANNEL_PROGRAMS[ch], timebaseNow());
+    }
+}
+
+// Clock users outside powerManager, rescaled with interrupts masked
+static void onSystemClock(uint32_t sysClock)
+{
+    gSystemClock = sysClock;
+
+    // timerLib counts milliseconds in Timer0A's periodic timeout interrupt;
+    // only the reload depends on the clock, so elapsedMillis keeps counting.
+    TimerLoadSet(TIMER0_BASE, TIMER_A, (sysClock / 1000U) - 1U);
+    gFrameGovernor.setClock(sysClock);
+#if APP_USE_RTOS
+    // The kernel tick comes from SysTick, which counts system clock cycles
+    SysTickPeriodSet(sysClock / configTICK_RATE_HZ);
+#endif
+}
+
+// Brings back each channel's last stopped time. Only the newest records are
+// read: a channel whose newest result is a reset (or that has none in the
+// scanned tail) starts from zero.
+static void restoreResults()
+{
+    uint32_t seen = 0U;
+    const uint32_t all = (1U << STOPWATCH_CHANNELS) - 1U;
+    const uint32_t stored = resultLogCount();
+    for (uint32_t i = 0; (i < stored) && (i < RESULT_LOG_RESTORE_SCAN) && (seen != all); i++) {
+        ResultRecord r;
+        if (!resultLogRead(i, r) || (r.channel >= STOPWATCH_CHANNELS) ||
+            (r.kind == RESULT_LAP)) {
+            continue;
+        }
+        const uint32_t bit = 1U << r.channel;
+        if (seen & bit) {
+            continue;
+        }
+        seen |= bit;
+        if (r.kind == RESULT_STOP) {
+            Stopwatch(r.channel).restore(timebaseMsToTicks(r.valueMs));
+        }
+    }
 }
 
 static void setupButtons()
 {
-    btnPlayPause.begin();
-    btnPlayPause.setTickIntervalMs(BUTTON_TICK_MS);
-    btnPlayPause.setDebounceMs(30);
+    // Inputs are debounced on every heartbeat, independent of the main loop
+    Inputs::begin({1000U / TIMEBASE_TICK_HZ, BUTTON_DEBOUNCE_MS, LONG_PRESS_MS, MULTI_CLICK_MS});
+    timebaseAddTickHook(sampleButtons);
+#if APP_HAS_LATENCY_REPLAY
+    latencyReplayInit();
+#endif
+}
 
-    btnReset.begin();
-    btnReset.setTickIntervalMs(BUTTON_TICK_MS);
-    btnReset.setDebounceMs(30);
+#if APP_HAS_LATENCY_REPLAY
+// LATENCY_TRACE's inputs 0 and 1
+static bool startLatencyReplay()
+{
+    static EdgeButton *const inputs[] = {&btnPlayPause, &btnReset};
+    return latencyReplayStart(LATENCY_TRACE, LATENCY_TRACE_LENGTH, inputs, 2U);
 }
+#endif
 
 // ============================================================================
 // Drawing functions
 // ============================================================================
-// Update function to display HH:MM:SS:MS
-static void drawStopwatchScreen(tContext &context, uint32_t currentSec, uint32_t currentMin, uint32_t currentHr, uint32_t currentMS , bool running)
+// Update function to display HH:MM:SS.mmm
+// Only widgets whose content changed are repainted. Returns true if anything
+// was drawn, so the caller can skip the flush on idle frames.
+static bool drawStopwatchScreen(tContext &context, uint32_t channel,
+                                uint32_t changedFields, bool running, const StopwatchView &view)
 {
-    tRectangle rectFull = {0, 0, 127, 127};
-    GrContextForegroundSet(&context, ClrBlack);
-    GrRectFill(&context, &rectFull);
+    ScopedProbe probe(PROF_DRAW_SCREEN);
 
-    // === Draw title "STOPWATCH" at the top ===
-    GrContextForegroundSet(&context, ClrCyan);
-    GrStringDrawCentered(&context, "STOPWATCH", -1, 64, 15, false);
+    // Time counter and state centered; only the fields gClock reported as
+    // changed are reformatted and restaged
+    gClock.format(changedFields, gTimeText);
+    char str2[] = "CHn STOPPED";
+    str2[2] = static_cast<char>('1' + channel);
+    if (view.phase == PHASE_DONE) {
+        memcpy(&str2[4], "DONE   ", 7);
+    } else if (running && (view.phase == PHASE_COUNTING)) {
+        memcpy(&str2[4], "RUNNING", 7);
+    } else if (running) {
+        // "WORK rr" / "REST rr"
+        memcpy(&str2[4], (view.phase == PHASE_WORK) ? "WORK " : "REST ", 5);
+        str2[9] = static_cast<char>('0' + (view.round / 10U) % 10U);
+        str2[10] = static_cast<char>('0' + view.round % 10U);
+    }
+
+    const uint32_t color = running ? ClrYellow : ClrOlive;
+    wTime.setCells(gTimeText, clockFieldCells(changedFields),
+                   running ? gDigitsRunning : gDigitsStopped);
+    wState.set(str2, color);
 
-    // Draw seconds counter and state centered
-    char str[10];
-    snprintf(str, sizeof(str), "%02u:%02u:%02u:%02u", currentHr, currentMin, currentSec, currentMS);
-    snprintf(str, sizeof(str), "%02u s", currentSec);
-    std::string str2 = running ? "RUNNING" : "STOPPED";
+    // Channels can also be toggled from their GPIO inputs, so the button
+    // labels follow the shown channel's state rather than the last click
+    gButtons.setLabel(BTN_START, running ? "PAUSE" : "PLAY");
+    gButtons.setLabel(BTN_RESET, running ? "LAP" : "RESET");
 
-    GrContextForegroundSet(&context, running ? ClrYellow : ClrOlive);
-    GrStringDrawCentered(&context, str, -1, 64, 50, false);
+    // Most recent lap as "Lnn HH:MM:SS.mmm". Copied out in one piece, since
+    // a lap can be recorded while the frame is being drawn.
+    char lapStr[4U + TIME_TEXT_LEN + 1U] = "";
+    Lap lap;
+    bool hasLap;
+    {
+        CriticalSection cs;
+        const Lap *latest = gLaps[channel].latest();
+        hasLap = (latest != nullptr);
+        if (hasLap) {
+            lap = *latest;
+        }
+    }
+    if (hasLap) {
+        char lapTime[TIME_TEXT_LEN + 1U];
+        formatTimeMs(static_cast<uint32_t>(timebaseTicksToMs(lap.lapTicks)), lapTime);
+        lapStr[0] = 'L';
+        timeFormatPutPair(&lapStr[1], lap.number % 100U);
+        lapStr[3] = ' ';
+        for (uint32_t i = 0; i <= TIME_TEXT_LEN; i++) {
+            lapStr[4U + i] = lapTime[i];
+        }
+    }
+    wLap.set(lapStr, ClrWhite);
 
-    GrStringDrawCentered(&context, str2.c_str(), -1, 64, 40, false);
+    bool painted = false;
+    painted |= wState.draw(context);
+    painted |= wLap.draw(context);
+    painted |= wTime.draw();
+    painted |= gButtons.draw(context);
+    return painted;
 }
 
-static void drawButton(tContext &context, const MyButton &btn)
+// Writes 'value' in decimal without leading zeros; returns the digit count
+static uint32_t putDecimal(char *out, uint32_t value)
 {
-    uint16_t bgColor = btn.pressed ? ClrBlack : ClrGray;
-    uint16_t textColor = btn.pressed ? ClrWhite : ClrBlack;
+    char digits[10];
+    uint32_t n = 0U;
+    do {
+        digits[n++] = static_cast<char>('0' + value % 10U);
+        value /= 10U;
+    } while (value != 0U);
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = digits[n - 1U - i];
+    }
+    return n;
+}
 
-    tRectangle rect = {btn.x, btn.y, btn.x + btn.w - 1, btn.y + btn.h - 1};
-    GrContextForegroundSet(&context, bgColor);
-    GrRectFill(&context, &rect);
+// "<label>HH:MM:SS.mmm"; 'label' is four characters
+static void putLabelledTime(char *out, const char *label, float ms)
+{
+    char time[TIME_TEXT_LEN + 1U];
+    formatTimeMs(static_cast<uint32_t>(ms + 0.5f), time);
+    memcpy(out, label, 4U);
+    memcpy(&out[4], time, TIME_TEXT_LEN + 1U);
+}
 
+// The stats page: laps, mean, standard deviation, trend and the histogram.
+// The rows are retained widgets, so only text that changed is redrawn, and
+// a new lap normally moves one bar: the histogram's scale only changes when
+// the peak passes a power of two. Returns true if anything was drawn.
+static bool drawLapStatsScreen(tContext &context, uint32_t channel)
+{
+    ScopedProbe probe(PROF_DRAW_SCREEN);
+
+    // A lap can be recorded while the frame is being drawn
+    LapStats<LAP_HISTOGRAM_BUCKETS> stats;
+    {
+        CriticalSection cs;
+        stats = gLapStats[channel];
+    }
+
+    char header[TextWidget::MAX_CHARS + 1U] = "CHn NO LAPS";
+    header[2] = static_cast<char>('1' + channel);
+    char mean[TextWidget::MAX_CHARS + 1U] = "";
+    char spread[TextWidget::MAX_CHARS + 1U] = "";
+    char trend[TextWidget::MAX_CHARS + 1U] = "";
+    char range[TextWidget::MAX_CHARS + 1U] = "";
+    if (stats.count() > 0U) {
+        memcpy(&header[4], "LAPS ", 5U);
+        header[9U + putDecimal(&header[9], stats.count())] = '\0';
+        putLabelledTime(mean, "AVG ", stats.meanMs());
+        putLabelledTime(spread, "SD  ", stats.stdDevMs());
+
+        // "TREND +s.mmms/lap", clamped to 999.999 s either way
+        const float perLap = stats.trendMsPerLap();
+        const float magnitude = (perLap < 0.0f) ? -perLap : perLap;
+        const uint32_t ms = (magnitude < 999999.0f) ? static_cast<uint32_t>(magnitude + 0.5f) : 999999U;
+        memcpy(trend, "TREND ", 6U);
+        trend[6] = (perLap < 0.0f) ? '-' : '+';
+        uint32_t n = 7U + putDecimal(&trend[7], ms / 1000U);
+        trend[n++] = '.';
+        trend[n++] = static_cast<char>('0' + (ms % 1000U) / 100U);
+        timeFormatPutPair(&trend[n], ms % 100U);
+        memcpy(&trend[n + 2U], "s/lap", 6U);
+
+        // "MM:SS.mmm  MM:SS.mmm", the first bucket's start and the last one's end
+        char time[TIME_TEXT_LEN + 1U];
+        formatTimeMs(stats.lowMs(), time);
+        memcpy(range, &time[3], 9U);
+        memcpy(&range[9], "  ", 2U);
+        formatTimeMs(stats.lowMs() + LAP_HISTOGRAM_BUCKETS * stats.widthMs(), time);
+        memcpy(&range[11], &time[3], 10U);
+    }
+    wStatsHeader.set(header, ClrYellow);
+    wStatsMean.set(mean, ClrWhite);
+    wStatsSpread.set(spread, ClrWhite);
+    wStatsTrend.set(trend, ClrWhite);
+    wStatsRange.set(range, ClrGray);
+
+    uint32_t fullScale = 4U;
+    while (fullScale < stats.peak()) {
+        fullScale <<= 1;
+    }
+    wHistogram.set(stats.buckets(), fullScale);
+
+    bool painted = false;
+    painted |= wStatsHeader.draw(context);
+    painted |= wStatsMean.draw(context);
+    painted |= wStatsSpread.draw(context);
+    painted |= wStatsTrend.draw(context);
+    painted |= wStatsRange.draw(context);
+    painted |= wHistogram.draw(context, STATS_BARS_PER_FRAME);
+    return painted;
+}
+
+// One strip of a page switch's clear. The last one hands the body to the
+// new page, whose widgets then repaint in full.
+static bool wipeBody(tContext &context)
+{
+    ScopedProbe probe(PROF_DRAW_SCREEN);
+
+    const int32_t end = Layout::BODY.y + Layout::BODY.h;
+    const int32_t y1 = (gWipeY + PAGE_WIPE_ROWS < end) ? (gWipeY + PAGE_WIPE_ROWS) : end;
+    tRectangle strip = {Layout::BODY.x, static_cast<int16_t>(gWipeY),
+                        static_cast<int16_t>(Layout::BODY.x + Layout::BODY.w - 1),
+                        static_cast<int16_t>(y1 - 1)};
     GrContextForegroundSet(&context, ClrBlack);
-    GrRectDraw(&context, &rect);
+    GrRectFill(&context, &strip);
+    gWipeY = y1;
 
-    GrContextForegroundSet(&context, textColor);
-    GrStringDrawCentered(&context, btn.label, -1,
-                         btn.x + btn.w / 2, btn.y + btn.h / 2, false);
+    if (gWipeY >= end) {
+        if (gShownPage == PAGE_LAP_STATS) {
+            wStatsHeader.invalidate();
+            wStatsMean.invalidate();
+            wStatsSpread.invalidate();
+            wStatsTrend.invalidate();
+            wStatsRange.invalidate();
+            wHistogram.invalidate();
+        } else {
+            gClockChannel = STOPWATCH_CHANNELS;   // reformat every field
+            wState.invalidate();
+            wLap.invalidate();
+            wTime.invalidate();
+            gButtons.invalidate();
+            gButtonsShown = true;
+        }
+    }
+    return true;
 }
 
 // ============================================================================
 // Button callbacks
 // ============================================================================
-static void onPlayPauseClick()
+// S1: a click starts or stops, a double click records a lap while running.
+// The first press toggles at once, so nothing else (S2, the photogate, a
+// GPIO input) can act on the channel ahead of it. A second press within
+// the double-click window takes that toggle back at the first press's time
+// and, if the channel was running, records the lap there instead, so the
+// double click costs no stopwatch time either. S2 and the photogate act on
+// the state as it is when they are pressed, and end the sequence: the next
+// S1 press is a click of its own. S1 and its touch twin share the sequence.
+static uint32_t gPlayPausePresses = 0;   // in the open click sequence
+static uint32_t gPlayPauseChannel = 0;
+static uint64_t gPlayPauseTicks = 0;     // its first press
+static bool gPlayPauseStarted = false;   // ... started the channel
+
+static void endPlayPauseSequence()
+{
+    gPlayPausePresses = 0U;
+}
+
+static void onPlayPausePress(uint64_t atTicks)
+{
+    if (gPlayPausePresses == 0U) {
+        Stopwatch sw(gShownChannel);
+        sw.toggle(atTicks);
+        gPlayPausePresses = 1U;
+        gPlayPauseChannel = gShownChannel;
+        gPlayPauseTicks = atTicks;
+        gPlayPauseStarted = sw.running();
+        latencyStateChanged(atTicks);
+        return;
+    }
+    if (++gPlayPausePresses != 2U) {
+        return;
+    }
+    Stopwatch sw(gPlayPauseChannel);
+    if (sw.running() == gPlayPauseStarted) {
+        sw.toggle(gPlayPauseTicks);
+        if (!gPlayPauseStarted) {
+            recordLap(gPlayPauseChannel, gPlayPauseTicks);
+        }
+        latencyStateChanged(atTicks);
+    }
+}
+
+// The sequence is over; its presses have all been applied
+static void onPlayPauseClicks(uint64_t, uint32_t)
 {
-    gRunning = !gRunning;
-    btnStart.label = gRunning ? "PAUSE" : "PLAY";
+    endPlayPauseSequence();
+}
+
+// A long press ends the sequence without reporting its clicks
+static void onPlayPauseLongPress(uint64_t)
+{
+    endPlayPauseSequence();
 }
 
 static void onPlayPauseRelease()
@@ -277,12 +938,189 @@ static void onPlayPauseRelease()
     // Optional visual or sound feedback
 }
 
-static void onResetClick()
+// S2: lap while running, reset while stopped
+static void onResetClick(uint64_t atTicks)
 {
-    gStopwatchMs = 0U;
+    endPlayPauseSequence();
+    if (Stopwatch(gShownChannel).running()) {
+        recordLap(gShownChannel, atTicks);
+    } else {
+        resetShownChannel(atTicks);
+    }
+    latencyStateChanged(atTicks);
 }
 
 static void onResetRelease()
 {
     // Optional visual or sound feedback
 }
+
+// S2 held: stop (at the time of the press) and reset, running or not. The
+// lap the press recorded goes with the reset.
+static void onResetLongPress(uint64_t atTicks)
+{
+    endPlayPauseSequence();
+    Stopwatch sw(gShownChannel);
+    if (sw.running()) {
+        sw.toggle(atTicks);
+    }
+    resetShownChannel(atTicks);
+    latencyStateChanged(atTicks);
+}
+
+static void recordLap(uint32_t channel, uint64_t atTicks)
+{
+    const Lap &lap = gLaps[channel].record(Stopwatch(channel).ticksAt(atTicks));
+    const uint32_t lapMs = static_cast<uint32_t>(timebaseTicksToMs(lap.lapTicks));
+    gLapStats[channel].add(lapMs);
+    telemetryPost(TELEM_LAP, channel, atTicks, lap.number);
+    resultLogAppend(RESULT_LAP, channel, lap.number, lapMs);
+}
+
+static void resetShownChannel(uint64_t atTicks)
+{
+    gLaps[gShownChannel].reset();
+    gLapStats[gShownChannel].reset();
+    Stopwatch(gShownChannel).reset(atTicks);
+    gStopwatchMs = 0U;
+}
+
+// USR_SW1: each click pages to the next channel, once the click sequence
+// is over; held, it switches between the stopwatch and the statistics page
+// instead (a long press reports no clicks), staying on the channel
+static void onChannelClicks(uint64_t atTicks, uint32_t clicks)
+{
+    gShownChannel = (gShownChannel + clicks) % STOPWATCH_CHANNELS;
+    latencyStateChanged(atTicks);
+}
+
+static void onChannelLongPress(uint64_t)
+{
+    gRequestedPage = (gRequestedPage == PAGE_STOPWATCH) ? PAGE_LAP_STATS : PAGE_STOPWATCH;
+}
+
+// Photogate: the first beam break starts the shown channel, every later one
+// records a lap. Both use the time the port interrupt stamped on the edge.
+static void onGatePress(uint64_t atTicks)
+{
+    endPlayPauseSequence();
+    Stopwatch sw(gShownChannel);
+    if (sw.running()) {
+        recordLap(gShownChannel, atTicks);
+    } else {
+        sw.start(atTicks);
+    }
+    latencyStateChanged(atTicks);
+}
+
+// Makes the next frame due now
+static void requestFrame()
+{
+#if APP_USE_RTOS
+    if (gRenderTask != nullptr) {
+        xTaskNotifyGive(gRenderTask);
+    }
+#else
+    gScheduler.trigger(gDisplayEvent);
+#endif
+}
+
+// Timebase heartbeat (interrupt context)
+static void sampleButtons(uint64_t nowTicks)
+{
+    Inputs::sample(nowTicks, gInputEvents);
+}
+
+#if LCD_USE_FRAMEBUFFER
+// Runs in the LCD DMA interrupt once the last dirty strip is on the panel
+static void onFlushComplete()
+{
+    gLastFlushCycles = profilerCycles() - gFlushStartCycles;
+    latencyFlushDone();
+}
+#endif
+
+#if APP_USE_RTOS
+// ============================================================================
+// Task model
+//
+// The same services as the superloop, split over three FreeRTOS tasks by
+// how much their timing matters. Time itself is never a task: the timebase
+// counts in hardware, and the heartbeat (input sampling) and edge captures
+// run at interrupt priority 0, above configMAX_SYSCALL_INTERRUPT_PRIORITY,
+// so neither the kernel nor any task can delay them. They reach the tasks
+// through the lock-free queues they already use (gInputEvents, telemetry,
+// the result log), and every event carries its own timestamp.
+//
+//   input   (highest)  runs the input handlers every BUTTON_TICK_MS and
+//                      wakes the renderer for feedback
+//   results            programs the EEPROM log and serves the debug UART
+//   render  (lowest)   runs power management and then one frame whenever
+//                      a frame is requested or the governor's period runs out
+//
+// Rendering is preempted by both other tasks. It owns the display, the
+// widgets and the button panel; what it reads from the handlers' side is the
+// shown channel (one word) and the latest lap (copied in a critical section).
+// Clock switches are made from the render task between frames, so no task
+// is ever on the LCD bus when its rate changes.
+//
+// The build supplies FreeRTOSConfig.h (with configUSE_IDLE_HOOK = 1 and the
+// kernel interrupt priorities below 0x00) and routes the SVCall, PendSV and
+// SysTick vectors to the port's handlers.
+// ============================================================================
+static constexpr uint32_t TASK_STACK_WORDS = 512U;
+static constexpr UBaseType_t INPUT_TASK_PRIORITY = tskIDLE_PRIORITY + 3U;
+static constexpr UBaseType_t RESULTS_TASK_PRIORITY = tskIDLE_PRIORITY + 2U;
+static constexpr UBaseType_t RENDER_TASK_PRIORITY = tskIDLE_PRIORITY + 1U;
+
+static void inputTask(void *)
+{
+    TickType_t wake = xTaskGetTickCount();
+    while (true) {
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(BUTTON_TICK_MS));
+        serviceButtons();
+    }
+}
+
+static void resultsTask(void *)
+{
+    TickType_t wake = xTaskGetTickCount();
+    uint32_t sinceDebugMs = 0U;
+    while (true) {
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(RESULT_LOG_SERVICE_MS));
+        serviceResultLog();
+        sinceDebugMs += RESULT_LOG_SERVICE_MS;
+        if (sinceDebugMs >= DEBUG_POLL_MS) {
+            sinceDebugMs = 0U;
+            serviceDebug();
+        }
+    }
+}
+
+static void renderTask(void *)
+{
+    while (true) {
+        servicePower();
+        serviceDisplay();
+        // A requested frame starts at once, otherwise the governor paces them
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(displayPeriodMs()));
+    }
+}
+
+static void startTasks()
+{
+    xTaskCreate(inputTask, "input", TASK_STACK_WORDS, nullptr, INPUT_TASK_PRIORITY, nullptr);
+    xTaskCreate(resultsTask, "results", TASK_STACK_WORDS, nullptr, RESULTS_TASK_PRIORITY, nullptr);
+    xTaskCreate(renderTask, "render", TASK_STACK_WORDS, nullptr, RENDER_TASK_PRIORITY,
+                &gRenderTask);
+    vTaskStartScheduler();
+    while (true) {
+    }
+}
+
+// Nothing ready: sleep until the next interrupt (at the latest the heartbeat)
+extern "C" void vApplicationIdleHook(void)
+{
+    CPUwfi();
+}
+#endif
@@ -0,0 +1,104 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "driverlib/eeprom.h"
+#include "driverlib/sysctl.h"
+}
+
+#include "powerManager.h"
+#include "criticalSection.h"
+#include "lcdFramebuffer.h"
+#include "profiler.h"
+#include "telemetry.h"
+#include "timebase.h"
+
+static constexpr uint32_t VCO_HZ = 480000000U;
+static constexpr uint32_t CLOCK_CONFIG = SYSCTL_XTAL_25MHZ | SYSCTL_OSC_MAIN |
+                                         SYSCTL_USE_PLL | SYSCTL_CFG_VCO_480;
+
+static PowerConfig sConfig = {0U, 0U, 0U, nullptr};
+static PowerLevel sLevel = POWER_FULL;
+static bool sEnabled = false;
+static uint64_t sIdleTicks = 0;
+static uint64_t sLastActive = 0;
+static uint32_t sSwitches = 0;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+static bool busy()
+{
+    return lcdFramebufferBusy() || telemetryBusy() ||
+           ((EEPROMStatusGet() & EEPROM_RC_WORKING) != 0U);
+}
+
+static bool switchTo(PowerLevel level)
+{
+    const uint32_t target = (level == POWER_FULL) ? sConfig.fullHz : sConfig.lowHz;
+
+    // Frames posted meanwhile queue up and go out at the new baud rate
+    telemetryHold(true);
+    bool switched = false;
+    {
+        CriticalSection cs;
+        const uint32_t clock = SysCtlClockFreqSet(CLOCK_CONFIG, target);
+        if ((clock == target) && timebaseSetClock(clock)) {
+            lcdSetSysClock(clock);
+            profilerSetClock(clock);
+            if (sConfig.onClock != nullptr) {
+                sConfig.onClock(clock);
+            }
+            sLevel = level;
+            sSwitches++;
+            switched = true;
+        }
+    }
+    telemetryHold(false);
+    return switched;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+void powerInit(const PowerConfig &config)
+{
+    sConfig = config;
+    sLevel = POWER_FULL;
+    sEnabled = (config.lowHz != 0U) && (config.lowHz < config.fullHz) &&
+               ((config.fullHz % config.lowHz) == 0U) && ((VCO_HZ % config.lowHz) == 0U);
+    sIdleTicks = timebaseMsToTicks(config.idleMs);
+    sLastActive = timebaseNow();
+    sSwitches = 0U;
+}
+
+bool powerUpdate(uint64_t nowTicks, bool active)
+{
+    if (active) {
+        sLastActive = nowTicks;
+    }
+    if (!sEnabled) {
+        return false;
+    }
+
+    PowerLevel want = sLevel;
+    if (active) {
+        want = POWER_FULL;
+    } else if ((nowTicks - sLastActive) >= sIdleTicks) {
+        want = POWER_LOW;
+    }
+    if ((want == sLevel) || busy()) {
+        return false;   // a busy peripheral just postpones the switch
+    }
+    return switchTo(want);
+}
+
+PowerLevel powerLevel()
+{
+    return sLevel;
+}
+
+uint32_t powerSwitchCount()
+{
+    return sSwitches;
+}
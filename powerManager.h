@@ -0,0 +1,54 @@
+#ifndef POWER_MANAGER_H_
+#define POWER_MANAGER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// System clock scaling
+//
+// The core runs at the full PLL clock while anything is being timed or is
+// changing on screen, and drops to a lower PLL clock once nothing has been
+// for a while. Any activity (an input edge, a running channel) brings it
+// straight back.
+//
+// Both clocks are divisions of the same 480 MHz VCO, so the PLL stays locked
+// across a switch and only the system divider changes. Everything that
+// counts system clock cycles is rescaled in the same interrupt-masked
+// section as the switch:
+//   - the timebase (timebaseSetClock), whose ticks keep the full-clock rate,
+//     so timestamps, stopwatch channels and gestures never see the change
+//   - the LCD's SPI bit rate and UART0's baud divisor
+//   - whatever the application registers as PowerConfig::onClock
+//
+// Switches wait until the LCD DMA, the telemetry stream and the EEPROM are
+// idle, so no transfer is ever retimed halfway. Deep-sleep is not used: the
+// timebase counter must keep counting system clock cycles.
+// ============================================================================
+
+enum PowerLevel : uint8_t {
+    POWER_FULL = 0,
+    POWER_LOW  = 1
+};
+
+struct PowerConfig {
+    uint32_t fullHz;                     // clock at boot
+    uint32_t lowHz;                      // must divide fullHz and 480 MHz
+    uint32_t idleMs;                     // quiet time before dropping to lowHz
+    void (*onClock)(uint32_t sysClock);  // rescales the application's users
+};
+
+// Call after timebaseInit(), lcdFramebufferInit() and telemetryInit(), at
+// the full clock. A lowHz that cannot be reached exactly disables scaling.
+void powerInit(const PowerConfig &config);
+
+// Main loop. 'active' means something needs the full clock right now; after
+// idleMs without it the clock drops. Returns true if the clock changed.
+bool powerUpdate(uint64_t nowTicks, bool active);
+
+PowerLevel powerLevel();
+
+// Clock switches made so far (each way counts)
+uint32_t powerSwitchCount();
+
+#endif // POWER_MANAGER_H_
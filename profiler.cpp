@@ -0,0 +1,171 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "driverlib/gpio.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+#include "inc/hw_memmap.h"
+}
+
+#include "criticalSection.h"
+#include "profiler.h"
+#include "telemetry.h"
+
+#if !SIM_BUILD
+// Cortex-M4 debug registers
+static volatile uint32_t &DEMCR    = *reinterpret_cast<volatile uint32_t *>(0xE000EDFCU);
+static volatile uint32_t &DWT_CTRL = *reinterpret_cast<volatile uint32_t *>(0xE0001000U);
+static volatile uint32_t &DWT_CYC  = *reinterpret_cast<volatile uint32_t *>(0xE0001004U);
+static constexpr uint32_t DEMCR_TRCENA      = 1U << 24;
+static constexpr uint32_t DWT_CTRL_CYCCNTENA = 1U << 0;
+#endif
+
+static const char *const PROBE_NAMES[PROF_COUNT] = {
+    "drawStopwatchScreen",
+    "drawButton",
+    "Button::tick",
+};
+
+static ProfileStats sStats[PROF_COUNT];
+
+// ============================================================================
+// Helpers
+// ============================================================================
+static uint32_t histogramBucket(uint32_t cycles)
+{
+    const uint32_t scaled = cycles >> PROF_HIST_SHIFT;
+    if (scaled == 0U) {
+        return 0U;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    const uint32_t bucket = 32U - static_cast<uint32_t>(__builtin_clz(scaled));
+#else
+    uint32_t bucket = 0U;
+    for (uint32_t v = scaled; v != 0U; v >>= 1) {
+        bucket++;
+    }
+#endif
+    return (bucket < PROF_HIST_BUCKETS) ? bucket : (PROF_HIST_BUCKETS - 1U);
+}
+
+static void putString(const char *s)
+{
+    while (*s != '\0') {
+        UARTCharPut(UART0_BASE, *s++);
+    }
+}
+
+static void putDecimal(uint64_t value)
+{
+    char digits[20];
+    uint32_t n = 0;
+    do {
+        digits[n++] = static_cast<char>('0' + (value % 10U));
+        value /= 10U;
+    } while (value != 0U);
+    while (n > 0U) {
+        UARTCharPut(UART0_BASE, digits[--n]);
+    }
+}
+
+static void putField(const char *label, uint64_t value)
+{
+    putString(label);
+    putDecimal(value);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+void profilerInit(uint32_t sysClock)
+{
+#if !SIM_BUILD
+    DEMCR |= DEMCR_TRCENA;
+    DWT_CYC = 0U;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+#endif
+    profilerReset();
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_UART0)) {
+    }
+    GPIOPinConfigure(GPIO_PA0_U0RX);
+    GPIOPinConfigure(GPIO_PA1_U0TX);
+    GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+    profilerSetClock(sysClock);
+}
+
+void profilerSetClock(uint32_t sysClock)
+{
+    UARTConfigSetExpClk(UART0_BASE, sysClock, 115200,
+                        UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
+}
+
+void profilerRecord(ProfileId id, uint32_t cycles)
+{
+    ProfileStats &s = sStats[id];
+    if ((s.count == 0U) || (cycles < s.minCycles)) {
+        s.minCycles = cycles;
+    }
+    if (cycles > s.maxCycles) {
+        s.maxCycles = cycles;
+    }
+    s.count++;
+    s.totalCycles += cycles;
+    s.histogram[histogramBucket(cycles)]++;
+}
+
+const ProfileStats &profilerStats(ProfileId id)
+{
+    return sStats[id];
+}
+
+void profilerReset()
+{
+    // Input sampling records from the heartbeat ISR; a sample landing halfway
+    // through clearing its entry would leave it torn
+    CriticalSection cs;
+    for (uint32_t i = 0; i < PROF_COUNT; i++) {
+        sStats[i] = ProfileStats();
+    }
+}
+
+void profilerPollUart()
+{
+    while (UARTCharsAvail(UART0_BASE)) {
+        const int32_t c = UARTCharGetNonBlocking(UART0_BASE);
+        if (c == 'p') {
+            profilerDumpUart();
+        } else if (c == 'r') {
+            profilerReset();
+            telemetryHold(true);
+            putString("profile reset\r\n");
+            telemetryHold(false);
+        }
+    }
+}
+
+void profilerDumpUart()
+{
+    // Keep telemetry frames out of the middle of the text
+    telemetryHold(true);
+    putString("probe,count,min,max,mean,hist(<2^8..)\r\n");
+    for (uint32_t i = 0; i < PROF_COUNT; i++) {
+        const ProfileStats &s = sStats[i];
+        putString(PROBE_NAMES[i]);
+        putField(",", s.count);
+        putField(",", s.minCycles);
+        putField(",", s.maxCycles);
+        putField(",", (s.count > 0U) ? (s.totalCycles / s.count) : 0U);
+        for (uint32_t b = 0; b < PROF_HIST_BUCKETS; b++) {
+            putField((b == 0U) ? ",[" : " ", s.histogram[b]);
+        }
+        putString("]\r\n");
+    }
+    putField("telemetry dropped,", telemetryDropped());
+    putString("\r\n");
+    telemetryHold(false);
+}
@@ -0,0 +1,102 @@
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Cycle-accurate on-target profiling
+//
+// ScopedProbe reads the DWT cycle counter on entry and exit and folds the
+// difference into a static per-probe table: count, min, max, mean and a
+// log2 histogram. The table is dumped as text over UART0 when a 'p' is
+// received ('r' clears it), so frame-time regressions are measured on the
+// real hardware instead of guessed.
+//
+// Build with PROFILE_ENABLE=0 to compile every probe away.
+// ============================================================================
+
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE 1
+#endif
+
+// Host simulation build (sim/): there is no DWT, cycles come from the
+// simulated clock instead
+#ifndef SIM_BUILD
+#define SIM_BUILD 0
+#endif
+
+enum ProfileId {
+    PROF_DRAW_SCREEN = 0,   // a frame: drawStopwatchScreen, drawLapStatsScreen or wipeBody
+    PROF_DRAW_BUTTON,       // drawButton
+    PROF_BUTTON_TICK,       // Button::tick / EdgeButton::tick
+    PROF_COUNT
+};
+
+// Bucket i counts samples below 2^(PROF_HIST_SHIFT + i) cycles; the last
+// bucket takes everything larger.
+static constexpr uint32_t PROF_HIST_BUCKETS = 16U;
+static constexpr uint32_t PROF_HIST_SHIFT   = 8U;   // 256 cycles ~ 2 us @ 120 MHz
+
+struct ProfileStats {
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint64_t totalCycles;
+    uint32_t histogram[PROF_HIST_BUCKETS];
+};
+
+// Enables the DWT cycle counter and UART0 (115200 8N1) for reports.
+void profilerInit(uint32_t sysClock);
+
+// Keeps UART0 at 115200 baud after a system clock change. Call with the
+// UART idle (telemetry held). Cycle counts recorded afterwards are at the
+// new clock.
+void profilerSetClock(uint32_t sysClock);
+
+void profilerRecord(ProfileId id, uint32_t cycles);
+const ProfileStats &profilerStats(ProfileId id);
+void profilerReset();
+
+// Handles pending UART0 commands; call from the main loop.
+void profilerPollUart();
+
+// Writes the whole table to UART0 (blocking; only runs on request). The
+// telemetry stream is held while it runs.
+void profilerDumpUart();
+
+#if SIM_BUILD
+uint32_t simCycleCounter();
+
+static inline uint32_t profilerCycles()
+{
+    return simCycleCounter();
+}
+#else
+static inline uint32_t profilerCycles()
+{
+    return *reinterpret_cast<volatile uint32_t *>(0xE0001004U);   // DWT_CYCCNT
+}
+#endif
+
+#if PROFILE_ENABLE
+class ScopedProbe {
+public:
+    explicit ScopedProbe(ProfileId id) : m_id(id), m_start(profilerCycles()) {}
+    ~ScopedProbe() { profilerRecord(m_id, profilerCycles() - m_start); }
+
+    ScopedProbe(const ScopedProbe &) = delete;
+    ScopedProbe &operator=(const ScopedProbe &) = delete;
+
+private:
+    ProfileId m_id;
+    uint32_t m_start;
+};
+#else
+class ScopedProbe {
+public:
+    explicit ScopedProbe(ProfileId) {}
+};
+#endif
+
+#endif // PROFILER_H_
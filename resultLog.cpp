@@ -0,0 +1,190 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "driverlib/eeprom.h"
+#include "driverlib/sysctl.h"
+}
+
+#include "crc8.h"
+#include "criticalSection.h"
+#include "resultLog.h"
+#include "spscQueue.h"
+
+static constexpr uint32_t RECORD_WORDS = 4U;
+static constexpr uint32_t RECORD_BYTES = RECORD_WORDS * 4U;
+
+// Upper 24 bits of the last word; an erased slot (all ones) never matches
+static constexpr uint32_t RECORD_MAGIC = 0xA5A5A500U;
+
+// Pending records; appends may come from the GPIO sampling ISR as well as
+// the main loop, so pushes are serialized with a critical section.
+static SpscQueue<ResultRecord, 16> sPending;
+
+static bool sReady = false;
+static uint32_t sSlots = 0;      // capacity of the region, in records
+static uint32_t sHead = 0;       // next slot to write
+static uint32_t sCount = 0;
+static uint32_t sNextSequence = 0;
+
+// Record being programmed, one word per service call
+static uint32_t sWords[RECORD_WORDS];
+static uint32_t sWordIndex = RECORD_WORDS;   // == RECORD_WORDS: idle
+
+// ============================================================================
+// Helpers
+// ============================================================================
+static void encode(const ResultRecord &r, uint32_t (&words)[RECORD_WORDS])
+{
+    words[0] = r.sequence;
+    words[1] = static_cast<uint32_t>(r.kind) | (static_cast<uint32_t>(r.channel) << 8) |
+               (static_cast<uint32_t>(r.number) << 16);
+    words[2] = r.valueMs;
+
+    uint8_t bytes[12];
+    for (uint32_t i = 0; i < 12U; i++) {
+        bytes[i] = static_cast<uint8_t>(words[i / 4U] >> (8U * (i % 4U)));
+    }
+    words[3] = RECORD_MAGIC | crc8(bytes, sizeof(bytes));
+}
+
+// Reads and checks one slot
+static bool readSlot(uint32_t slot, ResultRecord &r)
+{
+    uint32_t words[RECORD_WORDS];
+    EEPROMRead(words, slot * RECORD_BYTES, RECORD_BYTES);
+
+    r.sequence = words[0];
+    r.kind = static_cast<ResultKind>(words[1] & 0xFFU);
+    r.channel = static_cast<uint8_t>(words[1] >> 8);
+    r.number = static_cast<uint16_t>(words[1] >> 16);
+    r.valueMs = words[2];
+
+    uint32_t check[RECORD_WORDS];
+    encode(r, check);
+    return check[3] == words[3];
+}
+
+// True while 'slot' still continues the run of consecutive sequence numbers
+// that starts at 'first'
+static bool continuesRun(uint32_t slot, uint32_t first, uint32_t firstSequence)
+{
+    ResultRecord r;
+    return readSlot(slot, r) && ((r.sequence - firstSequence) == (slot - first));
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+bool resultLogInit()
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_EEPROM0);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_EEPROM0)) {
+    }
+    if (EEPROMInit() != EEPROM_INIT_OK) {
+        return false;
+    }
+    sSlots = EEPROMSizeGet() / RECORD_BYTES;
+
+    // Only the slot being written at reset can be torn, so if slot 0 fails
+    // its check the run starts at slot 1 (the log had wrapped onto slot 0).
+    ResultRecord r;
+    uint32_t first = 0U;
+    if (!readSlot(0U, r)) {
+        first = 1U;
+        if (!readSlot(1U, r)) {
+            sHead = 0U;
+            sCount = 0U;
+            sNextSequence = 0U;
+            sReady = true;
+            return true;
+        }
+    }
+    const uint32_t firstSequence = r.sequence;
+
+    // Slots [first, newest] hold consecutive sequence numbers and the next
+    // slot breaks the run (erased, torn, or an older lap of the ring).
+    uint32_t lo = first;          // continuesRun(lo) holds
+    uint32_t hi = sSlots;         // first slot known not to
+    while ((hi - lo) > 1U) {
+        const uint32_t mid = lo + (hi - lo) / 2U;
+        if (continuesRun(mid, first, firstSequence)) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    const uint32_t newest = lo;
+
+    readSlot(newest, r);
+    sNextSequence = r.sequence + 1U;
+    sHead = (newest + 1U == sSlots) ? 0U : newest + 1U;
+
+    // Past the head lie older records if the log has wrapped; the head slot
+    // itself may be the torn one, so look one further as well.
+    ResultRecord next;
+    const uint32_t afterHead = (sHead + 1U == sSlots) ? 0U : sHead + 1U;
+    const bool wrapped = (first != 0U) || readSlot(sHead, next) || readSlot(afterHead, next);
+    sCount = wrapped ? sSlots : (newest + 1U);
+
+    sReady = true;
+    return true;
+}
+
+bool resultLogAppend(ResultKind kind, uint32_t channel, uint32_t number, uint32_t valueMs)
+{
+    ResultRecord r;
+    r.sequence = 0U;   // assigned when it is written
+    r.kind = kind;
+    r.channel = static_cast<uint8_t>(channel);
+    r.number = static_cast<uint16_t>(number);
+    r.valueMs = valueMs;
+
+    CriticalSection cs;
+    return sPending.push(r);
+}
+
+void resultLogService()
+{
+    if (!sReady || (EEPROMStatusGet() & EEPROM_RC_WORKING)) {
+        return;
+    }
+
+    if (sWordIndex == RECORD_WORDS) {
+        ResultRecord r;
+        if (!sPending.pop(r)) {
+            return;
+        }
+        r.sequence = sNextSequence++;
+        encode(r, sWords);
+        sWordIndex = 0U;
+    }
+
+    // The check word goes last, so a record is only valid once complete
+    EEPROMProgramNonBlocking(sWords[sWordIndex], sHead * RECORD_BYTES + sWordIndex * 4U);
+    if (++sWordIndex < RECORD_WORDS) {
+        return;
+    }
+
+    sHead = (sHead + 1U == sSlots) ? 0U : sHead + 1U;
+    if (sCount < sSlots) {
+        sCount++;
+    }
+}
+
+uint32_t resultLogCount()
+{
+    return sCount;
+}
+
+bool resultLogRead(uint32_t i, ResultRecord &record)
+{
+    if (!sReady || (i >= sCount)) {
+        return false;
+    }
+    uint32_t slot = sHead + sSlots - 1U - i;
+    if (slot >= sSlots) {
+        slot -= sSlots;
+    }
+    return readSlot(slot, record);
+}
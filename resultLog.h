@@ -0,0 +1,59 @@
+#ifndef RESULT_LOG_H_
+#define RESULT_LOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Persistent result log in the on-chip EEPROM
+//
+// Results (stops, laps, resets) are appended to a circular, log-structured
+// region of fixed 16-byte records. Every record goes to the next slot in
+// turn, so each EEPROM word is rewritten only once per trip around the
+// region, and nothing is ever updated in place.
+//
+// Appending only queues the record in RAM. resultLogService() programs at
+// most one word per call, and only when the EEPROM is idle, so a slow
+// program or an internal erase never stalls the caller. A record carries a
+// sequence number and a CRC-8; a record cut short by a reset simply fails the
+// check and the log ends before it.
+//
+// Sequence numbers are consecutive from slot 0 up to the newest record, so
+// startup finds the head with a binary search (~9 record reads for the 6 KB
+// part) instead of scanning the whole region.
+// ============================================================================
+
+enum ResultKind : uint8_t {
+    RESULT_STOP  = 1,   // value = channel time when stopped, ms
+    RESULT_LAP   = 2,   // value = lap duration, ms; number = lap number
+    RESULT_RESET = 3    // value = 0
+};
+
+struct ResultRecord {
+    uint32_t sequence;
+    ResultKind kind;
+    uint8_t channel;
+    uint16_t number;
+    uint32_t valueMs;
+};
+
+// Enables the EEPROM and locates the log head. Blocking; call once at boot.
+// Returns false if the EEPROM could not be initialized (the log then stays
+// disabled and appends are dropped).
+bool resultLogInit();
+
+// Queues a record. Any context; returns false if the RAM queue is full.
+bool resultLogAppend(ResultKind kind, uint32_t channel, uint32_t number, uint32_t valueMs);
+
+// Programs the next pending word if the EEPROM is idle. Call from the main
+// loop every few milliseconds.
+void resultLogService();
+
+// Records held in the log (at most the region's capacity)
+uint32_t resultLogCount();
+
+// i-th stored record, 0 = newest. Reads the EEPROM directly; only valid for
+// i < resultLogCount(). Returns false if the slot fails its check.
+bool resultLogRead(uint32_t i, ResultRecord &record);
+
+#endif // RESULT_LOG_H_
@@ -0,0 +1,225 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "driverlib/hibernate.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/watchdog.h"
+#include "inc/hw_memmap.h"
+}
+
+#include "crc8.h"
+#include "resumeSnapshot.h"
+#include "stopwatch.h"
+#include "telemetry.h"
+#include "timebase.h"
+
+#if !SIM_BUILD
+// HIBCTL.WRC: the module has taken the last register write. HibernateDataSet()
+// waits for it after every word and always starts at word 0, so the
+// snapshot writes HIBDATA itself.
+static volatile uint32_t &HIB_CTL = *reinterpret_cast<volatile uint32_t *>(HIB_BASE + 0x010U);
+static constexpr uint32_t HIB_CTL_WRC = 1U << 31;
+
+static inline bool hibWriteReady()
+{
+    return (HIB_CTL & HIB_CTL_WRC) != 0U;
+}
+
+static inline void hibWrite(uint32_t index, uint32_t value)
+{
+    reinterpret_cast<volatile uint32_t *>(HIB_BASE + 0x030U)[index] = value;   // HIBDATA
+}
+
+// WDTCTL.WRC: WDT1 runs from PIOSC, and a write has to cross into its clock
+// domain before the next one
+static volatile uint32_t &WDT1_CTL = *reinterpret_cast<volatile uint32_t *>(WATCHDOG1_BASE + 0x008U);
+static constexpr uint32_t WDT_CTL_WRC = 1U << 31;
+
+static inline void waitWatchdogWrite()
+{
+    while ((WDT1_CTL & WDT_CTL_WRC) == 0U) {
+    }
+}
+#else
+static inline bool hibWriteReady() { return simHibernateWriteReady(); }
+static inline void hibWrite(uint32_t index, uint32_t value) { simHibernateWrite(index, value); }
+static inline void waitWatchdogWrite() {}
+#endif
+
+// Image layout: the header, then one word per channel
+static constexpr uint32_t SNAPSHOT_HEADER = 0U;
+static constexpr uint32_t SNAPSHOT_WORDS = 1U + STOPWATCH_CHANNELS;
+static constexpr uint32_t SNAPSHOT_MAGIC = 0x5357U << 16;   // "SW"
+static constexpr uint32_t PIOSC_HZ = 16000000U;
+
+static_assert(STOPWATCH_CHANNELS <= 8U, "the header holds an 8-bit running mask");
+static_assert(SNAPSHOT_WORDS <= 16U, "the hibernation module holds 16 words");
+
+// What the module holds, and the image to bring it to; only the heartbeat
+// touches either once snapshots have started
+static uint32_t sStored[SNAPSHOT_WORDS];
+static uint32_t sImage[SNAPSHOT_WORDS];
+static uint64_t sCaptureTicks = 0;
+static uint64_t sPeriodTicks = 0;
+static bool sValid = false;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+// RTC in ms, modulo 2^32; differences are valid across 49 days
+static uint32_t rtcMs()
+{
+    uint32_t seconds;
+    uint32_t sub;
+    do {
+        seconds = HibernateRTCGet();
+        sub = HibernateRTCSSGet() & 0x7FFFU;   // 1/32768 s
+    } while (seconds != HibernateRTCGet());
+    return (seconds * 1000U) + ((sub * 1000U) >> 15);
+}
+
+static uint32_t runningOf(const uint32_t *image)
+{
+    return (image[SNAPSHOT_HEADER] >> 8) & 0xFFU;
+}
+
+static uint32_t headerFor(const uint32_t *image, uint32_t running)
+{
+    uint32_t check[SNAPSHOT_WORDS];
+    check[0] = running;
+    for (uint32_t i = 1; i < SNAPSHOT_WORDS; i++) {
+        check[i] = image[i];
+    }
+    return SNAPSHOT_MAGIC | (running << 8) |
+           crc8(reinterpret_cast<const uint8_t *>(check), sizeof(check));
+}
+
+static bool isValid(const uint32_t *image)
+{
+    return image[SNAPSHOT_HEADER] == headerFor(image, runningOf(image));
+}
+
+// The image of every channel as of 'nowTicks'. A running channel keeps its
+// stored word unless it has drifted by more than the slack.
+static void capture(uint64_t nowTicks)
+{
+    const uint32_t rtc = rtcMs();
+    const uint32_t running = stopwatchRunningMask();
+    const uint32_t wasRunning = isValid(sStored) ? runningOf(sStored) : 0U;
+    for (uint32_t ch = 0; ch < STOPWATCH_CHANNELS; ch++) {
+        const uint32_t ms = static_cast<uint32_t>(timebaseTicksToMs(Stopwatch(ch).ticksAt(nowTicks)));
+        const uint32_t bit = 1U << ch;
+        uint32_t word = ms;
+        if (running & bit) {
+            word = ms - rtc;
+            const uint32_t drift = word - sStored[1U + ch];
+            if ((wasRunning & bit) &&
+                ((drift <= SNAPSHOT_SLACK_MS) || (drift >= 0U - SNAPSHOT_SLACK_MS))) {
+                word = sStored[1U + ch];
+            }
+        }
+        sImage[1U + ch] = word;
+    }
+    sImage[SNAPSHOT_HEADER] = headerFor(sImage, running);
+}
+
+// Writes the next word that differs from what is stored, the channels first
+// and the header last. Returns false once the image is all stored.
+static bool writeNext()
+{
+    for (uint32_t i = 1; i <= SNAPSHOT_WORDS; i++) {
+        const uint32_t word = i % SNAPSHOT_WORDS;
+        if (sImage[word] != sStored[word]) {
+            hibWrite(word, sImage[word]);
+            sStored[word] = sImage[word];
+            return true;
+        }
+    }
+    return false;
+}
+
+// Timebase heartbeat (interrupt context): one word if the module can take
+// it, and a new capture once the last one is stored and the period is up
+static void snapshotTick(uint64_t nowTicks)
+{
+    if (!hibWriteReady() || writeNext()) {
+        return;
+    }
+    if ((nowTicks - sCaptureTicks) >= sPeriodTicks) {
+        sCaptureTicks = nowTicks;
+        capture(nowTicks);
+        writeNext();
+    }
+}
+
+// ============================================================================
+// Snapshots
+// ============================================================================
+bool snapshotInit(uint32_t sysClock)
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_HIBERNATE);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_HIBERNATE)) {
+    }
+    // Active means the RTC has been counting on VBAT since the last run
+    const bool wasActive = HibernateIsActive();
+    HibernateEnableExpClk(sysClock);
+    HibernateClockConfig(HIBERNATE_OSC_LOWDRIVE);
+    HibernateRTCEnable();
+
+    HibernateDataGet(sStored, SNAPSHOT_WORDS);
+    sValid = wasActive && isValid(sStored);
+    for (uint32_t i = 0; i < SNAPSHOT_WORDS; i++) {
+        sImage[i] = sStored[i];
+    }
+    return sValid;
+}
+
+bool snapshotRestore(uint64_t atTicks)
+{
+    if (!sValid) {
+        return false;
+    }
+    const uint32_t rtc = rtcMs();
+    const uint32_t running = runningOf(sStored);
+    for (uint32_t ch = 0; ch < STOPWATCH_CHANNELS; ch++) {
+        const bool wasRunning = (running & (1U << ch)) != 0U;
+        const uint32_t ms = wasRunning ? (sStored[1U + ch] + rtc) : sStored[1U + ch];
+        Stopwatch(ch).resume(timebaseMsToTicks(ms), wasRunning, atTicks);
+    }
+    telemetryPost(TELEM_RESUME, STOPWATCH_CHANNELS, atTicks, running);
+    return true;
+}
+
+void snapshotStart()
+{
+    sPeriodTicks = timebaseMsToTicks(SNAPSHOT_PERIOD_MS);
+    sCaptureTicks = timebaseNow() - sPeriodTicks;   // the first capture is due now
+    timebaseAddTickHook(snapshotTick);
+}
+
+// ============================================================================
+// Watchdog
+// ============================================================================
+void watchdogStart(uint32_t timeoutMs)
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_WDOG1);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_WDOG1)) {
+    }
+    // The first timeout only raises the (unused) interrupt; the second one,
+    // if it has not been fed in between, resets
+    waitWatchdogWrite();
+    WatchdogReloadSet(WATCHDOG1_BASE, (PIOSC_HZ / 1000U) * (timeoutMs / 2U));
+    waitWatchdogWrite();
+    WatchdogResetEnable(WATCHDOG1_BASE);
+    waitWatchdogWrite();
+    WatchdogStallEnable(WATCHDOG1_BASE);   // stops while the debugger halts the core
+    waitWatchdogWrite();
+    WatchdogEnable(WATCHDOG1_BASE);
+}
+
+void watchdogFeed()
+{
+    waitWatchdogWrite();
+    WatchdogIntClear(WATCHDOG1_BASE);
+}
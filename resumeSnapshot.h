@@ -0,0 +1,66 @@
+#ifndef RESUME_SNAPSHOT_H_
+#define RESUME_SNAPSHOT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Resume after a brownout or watchdog reset
+//
+// The stopwatch state (which channels run, and each channel's time) is kept
+// in the hibernation module's battery-backed words, which survive any reset
+// and the loss of main power for as long as VBAT holds. At boot the channels
+// are put back before the display is even initialized, and running ones are
+// moved on by the time the board was off, as measured by the hibernation
+// RTC (which keeps counting on VBAT).
+//
+// A running channel is stored as its time minus the RTC's, in ms, which
+// stays put while it runs: the word only changes when the channel is
+// toggled or the two clocks have drifted apart by SNAPSHOT_SLACK_MS. A
+// stopped channel is stored as its time. The heartbeat captures the image
+// every SNAPSHOT_PERIOD_MS and writes at most one changed word per tick, and
+// only once the module has taken the previous one (a write takes three RTC
+// cycles, ~92 us), so nothing ever waits on it. The header word, with the
+// running mask and a CRC-8 over the image, goes last; a snapshot cut short
+// by a reset fails the check and the result log is used instead (see
+// main.cpp).
+//
+// The watchdog (WDT1, clocked from PIOSC so clock switches leave its timeout
+// alone) resets the chip if the main loop stops feeding it; the snapshot
+// then brings the timing back.
+// ============================================================================
+
+#ifndef SIM_BUILD
+#define SIM_BUILD 0
+#endif
+
+static constexpr uint32_t SNAPSHOT_PERIOD_MS = 20U;
+static constexpr uint32_t SNAPSHOT_SLACK_MS = 2U;
+
+// Enables the hibernation module and its RTC and reads back the snapshot the
+// last run left. Call once at boot; returns true if it is valid (taken by
+// this firmware, complete, and with the RTC counting ever since).
+bool snapshotInit(uint32_t sysClock);
+
+// Puts every channel back as the snapshot had it, as of 'atTicks'. Call
+// after the channels and their programs are set up. Returns false, and
+// changes nothing, if snapshotInit() found no valid snapshot.
+bool snapshotRestore(uint64_t atTicks);
+
+// Starts capturing and writing snapshots from the heartbeat. Call after
+// timebaseInit(); uses one tick hook.
+void snapshotStart();
+
+// Resets the chip unless watchdogFeed() is called at least every
+// 'timeoutMs'. Call once, at the end of initialization.
+void watchdogStart(uint32_t timeoutMs);
+void watchdogFeed();
+
+#if SIM_BUILD
+// The host simulation's hibernation data words (sim/simPeripherals.cpp):
+// whether the module can take a write, and the write itself
+bool simHibernateWriteReady();
+void simHibernateWrite(uint32_t index, uint32_t value);
+#endif
+
+#endif // RESUME_SNAPSHOT_H_
@@ -0,0 +1,189 @@
+#include <string.h>
+
+#include "retainedUi.h"
+#include "profiler.h"
+#include "staticUi.h"
+#include "lcdFramebuffer.h"
+
+// ============================================================================
+// Helpers
+// ============================================================================
+static void fillRect(tContext &context, int32_t x0, int32_t y0,
+                     int32_t x1, int32_t y1, uint32_t color)
+{
+    if ((x0 > x1) || (y0 > y1)) {
+        return;
+    }
+    tRectangle rect = {static_cast<int16_t>(x0), static_cast<int16_t>(y0),
+                       static_cast<int16_t>(x1), static_cast<int16_t>(y1)};
+    GrContextForegroundSet(&context, color);
+    GrRectFill(&context, &rect);
+}
+
+// Clears the parts of 'prev' that are not covered by 'next'.
+static void eraseUncovered(tContext &context, const tRectangle &prev,
+                           const tRectangle &next, uint32_t background)
+{
+    // Rows above and below the new box
+    fillRect(context, prev.i16XMin, prev.i16YMin, prev.i16XMax,
+             static_cast<int32_t>(next.i16YMin) - 1, background);
+    fillRect(context, prev.i16XMin, static_cast<int32_t>(next.i16YMax) + 1,
+             prev.i16XMax, prev.i16YMax, background);
+
+    // Columns left and right of the new box, within the shared rows
+    const int32_t y0 = (prev.i16YMin > next.i16YMin) ? prev.i16YMin : next.i16YMin;
+    const int32_t y1 = (prev.i16YMax < next.i16YMax) ? prev.i16YMax : next.i16YMax;
+    fillRect(context, prev.i16XMin, y0,
+             static_cast<int32_t>(next.i16XMin) - 1, y1, background);
+    fillRect(context, static_cast<int32_t>(next.i16XMax) + 1, y0,
+             prev.i16XMax, y1, background);
+}
+
+// ============================================================================
+// TextWidget
+// ============================================================================
+TextWidget::TextWidget(const TextBox &box, uint32_t background)
+    : m_box(box), m_background(background), m_color(0),
+      m_bounds(), m_hasBounds(false), m_dirty(true)
+{
+    m_text[0] = '\0';
+}
+
+void TextWidget::set(const char *text, uint32_t color)
+{
+    if ((color == m_color) && (strncmp(text, m_text, MAX_CHARS) == 0)) {
+        return;
+    }
+    strncpy(m_text, text, MAX_CHARS);
+    m_text[MAX_CHARS] = '\0';
+    m_color = color;
+    m_dirty = true;
+}
+
+bool TextWidget::draw(tContext &context)
+{
+    if (!m_dirty) {
+        return false;
+    }
+
+    int32_t chars = 0;
+    while ((chars < m_box.chars) && (m_text[chars] != '\0')) {
+        chars++;
+    }
+    const int32_t x0 = m_box.x;
+    const int32_t y0 = m_box.y;
+
+    tRectangle next = {static_cast<int16_t>(x0), static_cast<int16_t>(y0),
+                       static_cast<int16_t>(x0 + chars * m_box.cellW - 1),
+                       static_cast<int16_t>(y0 + m_box.cellH - 1)};
+
+    // Opaque text paints its own background, so there is no clear-then-draw
+    // flicker; only the leftovers of a wider previous string are erased.
+    GrContextForegroundSet(&context, m_color);
+    GrContextBackgroundSet(&context, m_background);
+    GrStringDraw(&context, m_text, chars, x0, y0, true);
+
+    if (m_hasBounds) {
+        eraseUncovered(context, m_bounds, next, m_background);
+    }
+
+    m_bounds = next;
+    m_hasBounds = true;
+    m_dirty = false;
+    return true;
+}
+
+// ============================================================================
+// BarGraphWidget
+// ============================================================================
+BarGraphWidget::BarGraphWidget(const BoxRect &box, uint32_t bars, int16_t barW, int16_t pitch,
+                               uint32_t color, uint32_t background)
+    : m_box(box), m_bars((bars < MAX_BARS) ? bars : MAX_BARS), m_barW(barW), m_pitch(pitch),
+      m_color(color), m_background(background), m_height(), m_drawn(), m_stale(0U), m_dirty(0U)
+{
+    invalidate();
+}
+
+void BarGraphWidget::invalidate()
+{
+    m_stale = (m_bars == 32U) ? 0xFFFFFFFFU : ((1U << m_bars) - 1U);
+    m_dirty = m_stale;
+}
+
+void BarGraphWidget::set(const uint16_t *values, uint32_t fullScale)
+{
+    const uint32_t boxH = static_cast<uint32_t>(m_box.h);
+    for (uint32_t i = 0; i < m_bars; i++) {
+        const uint32_t value = (values[i] < fullScale) ? values[i] : fullScale;
+        const uint8_t height = (fullScale > 0U) ? static_cast<uint8_t>(value * boxH / fullScale) : 0U;
+        m_height[i] = height;
+        const uint32_t bit = 1U << i;
+        if ((m_stale & bit) || (height != m_drawn[i])) {
+            m_dirty |= bit;
+        } else {
+            m_dirty &= ~bit;
+        }
+    }
+}
+
+bool BarGraphWidget::draw(tContext &context, uint32_t maxBars)
+{
+    const int32_t bottom = m_box.y + m_box.h - 1;
+    uint32_t drawn = 0U;
+    for (uint32_t i = 0; (i < m_bars) && (m_dirty != 0U) && (drawn < maxBars); i++) {
+        const uint32_t bit = 1U << i;
+        if ((m_dirty & bit) == 0U) {
+            continue;
+        }
+        const int32_t x0 = m_box.x + static_cast<int32_t>(i) * m_pitch;
+        const int32_t x1 = x0 + m_barW - 1;
+        const int32_t top = bottom - m_height[i] + 1;   // first row of the bar
+        if (m_stale & bit) {
+            fillRect(context, x0, m_box.y, x1, top - 1, m_background);
+            fillRect(context, x0, top, x1, bottom, m_color);
+        } else {
+            const int32_t drawnTop = bottom - m_drawn[i] + 1;
+            if (top < drawnTop) {
+                fillRect(context, x0, top, x1, drawnTop - 1, m_color);
+            } else {
+                fillRect(context, x0, drawnTop, x1, top - 1, m_background);
+            }
+        }
+        m_drawn[i] = m_height[i];
+        m_stale &= ~bit;
+        m_dirty &= ~bit;
+        drawn++;
+    }
+    return drawn > 0U;
+}
+
+// ============================================================================
+// Button painter
+// ============================================================================
+void drawButton(tContext &context, const MyButton &btn)
+{
+    ScopedProbe probe(PROF_DRAW_BUTTON);
+
+    // Known faces come pre-rasterized from flash as a single blit
+    const uint16_t *face = staticUiButtonFace(btn.label, btn.pressed, btn.w, btn.h);
+    if (face != nullptr) {
+        lcdBlit(btn.x, btn.y, btn.w, btn.h, face);
+        return;
+    }
+
+    uint32_t bgColor = btn.pressed ? ClrBlack : ClrGray;
+    uint32_t textColor = btn.pressed ? ClrWhite : ClrBlack;
+
+    tRectangle rect = {static_cast<int16_t>(btn.x), static_cast<int16_t>(btn.y),
+                       static_cast<int16_t>(btn.x + btn.w - 1),
+                       static_cast<int16_t>(btn.y + btn.h - 1)};
+    GrContextForegroundSet(&context, bgColor);
+    GrRectFill(&context, &rect);
+
+    GrContextForegroundSet(&context, ClrBlack);
+    GrRectDraw(&context, &rect);
+
+    GrContextForegroundSet(&context, textColor);
+    GrStringDrawCentered(&context, btn.label, -1,
+                         btn.x + btn.w / 2, btn.y + btn.h / 2, false);
+}
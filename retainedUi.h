@@ -0,0 +1,110 @@
+#ifndef RETAINED_UI_H_
+#define RETAINED_UI_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "grlib/grlib.h"
+}
+
+#include "screenLayout.h"
+
+// ============================================================================
+// Retained-mode widgets
+//
+// Each widget remembers what it last put on the panel. draw() only touches
+// the pixels inside the widget's bounding box, and only when the content
+// changed since the previous call, so a steady-state frame pushes nothing
+// over SPI.
+// ============================================================================
+
+// ============================================================================
+// STRUCT: Simple GUI Button (for drawing)
+// ============================================================================
+struct MyButton {
+    int x, y, w, h;
+    const char* label;
+    bool pressed;
+};
+
+// Paints a button unconditionally (background, outline and label). Faces
+// the static UI generator rendered are blitted straight to the active LCD
+// path; anything else is drawn with GrLib on 'context'.
+void drawButton(tContext &context, const MyButton &btn);
+
+// ============================================================================
+// CLASS: Text label in a fixed-pitch box
+// ============================================================================
+class TextWidget {
+public:
+    static constexpr uint32_t MAX_CHARS = 20U;
+
+    // Text starts at the box's first cell; the layout already centred the
+    // box for its full width, so nothing is measured when drawing. Longer
+    // text is cut at box.chars.
+    explicit TextWidget(const TextBox &box, uint32_t background = ClrBlack);
+
+    // Updates the content; marks the widget dirty only if it changed.
+    void set(const char *text, uint32_t color);
+
+    // Forces a repaint on the next draw() (e.g. after a full-screen clear).
+    void invalidate() { m_dirty = true; }
+
+    bool isDirty() const { return m_dirty; }
+    const tRectangle &bounds() const { return m_bounds; }
+
+    // Repaints the label if dirty. Returns true if any pixel was written.
+    bool draw(tContext &context);
+
+private:
+    TextBox m_box;
+    uint32_t m_background;
+    uint32_t m_color;
+    char m_text[MAX_CHARS + 1];
+    tRectangle m_bounds;    // area covered by the last paint
+    bool m_hasBounds;
+    bool m_dirty;
+};
+
+// ============================================================================
+// CLASS: Bar graph, e.g. a histogram
+// ============================================================================
+class BarGraphWidget {
+public:
+    static constexpr uint32_t MAX_BARS = 32U;
+
+    // 'bars' bars of 'barW' pixels every 'pitch' pixels from the box's left
+    // edge, growing up from its bottom (at most 255 pixels)
+    BarGraphWidget(const BoxRect &box, uint32_t bars, int16_t barW, int16_t pitch,
+                   uint32_t color, uint32_t background = ClrBlack);
+
+    // Updates the values; a bar the height of the box stands for
+    // 'fullScale' (larger values are cut). Only bars whose height in pixels
+    // changed are marked dirty.
+    void set(const uint16_t *values, uint32_t fullScale);
+
+    // Forces every bar to repaint in full on the next draw() calls.
+    void invalidate();
+
+    bool isDirty() const { return m_dirty != 0U; }
+
+    // Repaints up to 'maxBars' of the dirty bars, leftmost first, and leaves
+    // the rest for the next call. A bar that was drawn before only paints
+    // the rows it grew or shrank by. Returns true if any pixel was written.
+    bool draw(tContext &context, uint32_t maxBars = MAX_BARS);
+
+private:
+    BoxRect m_box;
+    uint32_t m_bars;
+    int16_t m_barW;
+    int16_t m_pitch;
+    uint32_t m_color;
+    uint32_t m_background;
+    uint8_t m_height[MAX_BARS];   // in pixels
+    uint8_t m_drawn[MAX_BARS];    // what is on the panel, unless stale
+    uint32_t m_stale;             // never drawn, or invalidated
+    uint32_t m_dirty;
+};
+
+#endif // RETAINED_UI_H_
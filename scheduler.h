@@ -0,0 +1,117 @@
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "driverlib/cpu.h"
+#include "driverlib/interrupt.h"
+}
+
+#include "elapsedTime.h"
+
+// ============================================================================
+// Timed event scheduler
+//
+// Each event owns an elapsedMillis and a period. dispatch() runs the events
+// that are due; idle() puts the core to sleep with WFI until the next
+// interrupt (at the latest the next timebase tick) when nothing is due, so
+// the main loop no longer spins at full power between ticks.
+// ============================================================================
+template <uint32_t MAX_EVENTS>
+class EventScheduler {
+public:
+    using Handler = void (*)();
+
+    // Registers a periodic event. Returns its id, or -1 if the table is full.
+    int32_t add(elapsedMillis &tick, uint32_t periodMs, Handler handler)
+    {
+        if (m_count >= MAX_EVENTS) {
+            return -1;
+        }
+        Event &e = m_events[m_count];
+        e.tick = &tick;
+        e.periodMs = periodMs;
+        e.handler = handler;
+        e.triggered = false;
+        tick = 0;
+        return static_cast<int32_t>(m_count++);
+    }
+
+    // Makes an event due on the next dispatch, regardless of its period.
+    void trigger(int32_t id)
+    {
+        if ((id >= 0) && (static_cast<uint32_t>(id) < m_count)) {
+            m_events[id].triggered = true;
+        }
+    }
+
+    // Changes an event's period; takes effect from its next run.
+    void setPeriod(int32_t id, uint32_t periodMs)
+    {
+        if ((id >= 0) && (static_cast<uint32_t>(id) < m_count)) {
+            m_events[id].periodMs = periodMs;
+        }
+    }
+
+    // Runs every due event once, in registration order. Returns true if any
+    // handler ran.
+    bool dispatch()
+    {
+        bool ran = false;
+        for (uint32_t i = 0; i < m_count; i++) {
+            Event &e = m_events[i];
+            const uint32_t elapsed = *e.tick;
+            if (!e.triggered && (elapsed < e.periodMs)) {
+                continue;
+            }
+
+            // Keep the phase when on time; resynchronize after a long stall
+            // instead of firing a burst of catch-up runs.
+            const uint32_t late = (elapsed >= e.periodMs) ? (elapsed - e.periodMs) : 0U;
+            *e.tick = (late < e.periodMs) ? late : 0U;
+            e.triggered = false;
+
+            e.handler();
+            ran = true;
+        }
+        return ran;
+    }
+
+    bool anyDue() const
+    {
+        for (uint32_t i = 0; i < m_count; i++) {
+            if (m_events[i].triggered ||
+                (static_cast<uint32_t>(*m_events[i].tick) >= m_events[i].periodMs)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Sleeps until the next interrupt unless an event is already due. The
+    // check runs with interrupts masked so a wake-up cannot slip in between
+    // the check and WFI; a pending interrupt still ends WFI while masked.
+    void idle()
+    {
+        IntMasterDisable();
+        if (!anyDue()) {
+            CPUwfi();
+        }
+        IntMasterEnable();
+    }
+
+private:
+    struct Event {
+        elapsedMillis *tick;
+        uint32_t periodMs;
+        Handler handler;
+        bool triggered;
+    };
+
+    Event m_events[MAX_EVENTS] = {};
+    uint32_t m_count = 0;
+};
+
+#endif // SCHEDULER_H_
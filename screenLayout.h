@@ -0,0 +1,195 @@
+#ifndef SCREEN_LAYOUT_H_
+#define SCREEN_LAYOUT_H_
+
+#include <stdint.h>
+
+extern "C" {
+#include "grlib/grlib.h"
+}
+
+#include "staticUi.h"
+
+// ============================================================================
+// Compile-time screen layout
+//
+// Every position on the stopwatch screen is derived here from the panel size
+// and the font's cell metrics, as constants. Widgets get their boxes ready
+// made, so nothing measures or centres a string at run time, and moving to
+// a larger panel or a bigger font is a change to the Layout alias in
+// main.cpp.
+//
+// Positions are designed on a 128x128 panel and scaled to the actual one;
+// text boxes are then sized from the font cells and centred on the scaled
+// anchors. The title, button faces and large digits come from
+// tools/gen_static_ui.py, which mirrors the default layout; update its
+// constants and rerun it for another one (buttons without a matching face
+// fall back to GrLib).
+// ============================================================================
+
+// Fixed-pitch font: every glyph sits in a CELL_W x CELL_H cell
+struct FontFixed6x8 {
+    static constexpr int32_t CELL_W = 6;
+    static constexpr int32_t CELL_H = 8;
+    static constexpr int32_t BASELINE = 7;   // rows above the baseline
+
+    static const tFont *font() { return &g_sFontFixed6x8; }
+};
+
+// Seven-segment time digits, RLE-compressed in flash (see staticUi.h)
+struct FontLargeDigits {
+    static constexpr int32_t CELL_W = 10;
+    static constexpr int32_t CELL_H = 16;
+
+    static const RleFont &font() { return STATIC_UI_LARGE_DIGITS; }
+};
+
+// Room for 'chars' cells of text; x/y is the first cell's top-left corner
+struct TextBox {
+    int16_t x, y;
+    int16_t cellW, cellH;
+    uint16_t chars;
+};
+
+struct BoxRect {
+    int16_t x, y, w, h;
+};
+
+// Hit test, e.g. for a touch at panel pixel x/y
+static constexpr bool boxContains(const BoxRect &box, int32_t x, int32_t y)
+{
+    return (x >= box.x) && (x < box.x + box.w) && (y >= box.y) && (y < box.y + box.h);
+}
+
+// Positions on the 128x128 design, scaled to a 'panel'-pixel dimension
+static constexpr int32_t LAYOUT_DESIGN_SIZE = 128;
+
+static constexpr int32_t layoutScale(int32_t v, int32_t panel)
+{
+    return v * panel / LAYOUT_DESIGN_SIZE;
+}
+
+template <typename Font>
+static constexpr TextBox centeredTextBox(int32_t cx, int32_t cy, uint32_t chars)
+{
+    return {static_cast<int16_t>(cx - (static_cast<int32_t>(chars) * Font::CELL_W) / 2),
+            static_cast<int16_t>(cy - Font::CELL_H / 2),
+            static_cast<int16_t>(Font::CELL_W), static_cast<int16_t>(Font::CELL_H),
+            static_cast<uint16_t>(chars)};
+}
+
+// Everything below the title, which the pages share: it is cleared when
+// the screen switches between them
+static constexpr BoxRect layoutBody(int32_t panelW, int32_t panelH)
+{
+    return {0, static_cast<int16_t>(layoutScale(24, panelH)),
+            static_cast<int16_t>(panelW),
+            static_cast<int16_t>(panelH - layoutScale(24, panelH))};
+}
+
+// FONT sets the state and lap text, DIGIT_FONT the time readout's cells
+template <int32_t PANEL_W, int32_t PANEL_H, typename FONT, typename DIGIT_FONT = FONT>
+struct StopwatchLayout {
+    using Font = FONT;
+    using DigitFont = DIGIT_FONT;
+
+    // "CHn RUNNING" / "CHn WORK rr" / ..., HH:MM:SS.mmm and "Lnn HH:MM:SS.mmm"
+    static constexpr uint32_t STATE_CHARS = 11U;
+    static constexpr uint32_t TIME_CHARS = 12U;
+    static constexpr uint32_t LAP_CHARS = 16U;
+
+    // Anchors on the design panel, scaled. Taller digits push the state
+    // row up by the extra height.
+    static constexpr int32_t CENTER_X = PANEL_W / 2;
+    static constexpr int32_t STATE_CY =
+        layoutScale(40, PANEL_H) - (DigitFont::CELL_H - Font::CELL_H) / 2;
+    static constexpr int32_t TIME_CY = layoutScale(50, PANEL_H);
+    static constexpr int32_t LAP_CY = layoutScale(64, PANEL_H);
+    static constexpr int16_t BUTTON_Y = static_cast<int16_t>(layoutScale(80, PANEL_H));
+    static constexpr int16_t BUTTON_W = static_cast<int16_t>(layoutScale(50, PANEL_W));
+    static constexpr int16_t BUTTON_H = static_cast<int16_t>(layoutScale(28, PANEL_H));
+    static constexpr int16_t BUTTON_PITCH = static_cast<int16_t>(layoutScale(60, PANEL_W));
+
+    static constexpr TextBox STATE = centeredTextBox<Font>(CENTER_X, STATE_CY, STATE_CHARS);
+    static constexpr TextBox TIME = centeredTextBox<DigitFont>(CENTER_X, TIME_CY, TIME_CHARS);
+    static constexpr TextBox LAP = centeredTextBox<Font>(CENTER_X, LAP_CY, LAP_CHARS);
+
+    static constexpr BoxRect START_BUTTON = {0, BUTTON_Y, BUTTON_W, BUTTON_H};
+    static constexpr BoxRect RESET_BUTTON = {BUTTON_PITCH, BUTTON_Y, BUTTON_W, BUTTON_H};
+    static constexpr BoxRect BODY = layoutBody(PANEL_W, PANEL_H);
+
+    static_assert((LAP_CHARS * Font::CELL_W) <= PANEL_W, "lap text does not fit the panel");
+    static_assert((TIME_CHARS * DigitFont::CELL_W) <= PANEL_W, "time digits do not fit the panel");
+    static_assert((RESET_BUTTON.x + RESET_BUTTON.w) <= PANEL_W, "buttons do not fit the panel");
+    static_assert((START_BUTTON.y + START_BUTTON.h) <= PANEL_H, "buttons do not fit the panel");
+    static_assert(STATE.y + STATE.cellH <= TIME.y, "state and time rows overlap");
+    static_assert(TIME.y + TIME.cellH <= LAP.y, "time and lap rows overlap");
+    static_assert(BODY.y <= STATE.y, "the state row runs into the title");
+};
+
+// The lap statistics page: four text rows (laps, mean, standard deviation,
+// trend), the histogram's BUCKETS bars and its range underneath
+template <int32_t PANEL_W, int32_t PANEL_H, typename FONT, uint32_t BUCKETS>
+struct LapStatsLayout {
+    using Font = FONT;
+
+    static constexpr uint32_t ROW_CHARS = 20U;   // TextWidget::MAX_CHARS
+
+    static constexpr int32_t CENTER_X = PANEL_W / 2;
+    static constexpr int32_t ROW_PITCH = layoutScale(10, PANEL_H);
+    static constexpr int32_t FIRST_ROW_CY = layoutScale(30, PANEL_H);
+    static constexpr int32_t RANGE_CY = layoutScale(121, PANEL_H);
+    static constexpr int16_t BAR_PITCH = static_cast<int16_t>(PANEL_W / static_cast<int32_t>(BUCKETS));
+    static constexpr int16_t BAR_W = static_cast<int16_t>(BAR_PITCH - 1);   // a 1 px gap
+
+    static constexpr TextBox HEADER = centeredTextBox<Font>(CENTER_X, FIRST_ROW_CY, ROW_CHARS);
+    static constexpr TextBox MEAN =
+        centeredTextBox<Font>(CENTER_X, FIRST_ROW_CY + ROW_PITCH, ROW_CHARS);
+    static constexpr TextBox SPREAD =
+        centeredTextBox<Font>(CENTER_X, FIRST_ROW_CY + 2 * ROW_PITCH, ROW_CHARS);
+    static constexpr TextBox TREND =
+        centeredTextBox<Font>(CENTER_X, FIRST_ROW_CY + 3 * ROW_PITCH, ROW_CHARS);
+    static constexpr TextBox RANGE = centeredTextBox<Font>(CENTER_X, RANGE_CY, ROW_CHARS);
+
+    static constexpr int16_t HISTOGRAM_Y = static_cast<int16_t>(layoutScale(68, PANEL_H));
+    static constexpr BoxRect HISTOGRAM = {
+        static_cast<int16_t>((PANEL_W - BAR_PITCH * static_cast<int32_t>(BUCKETS)) / 2),
+        HISTOGRAM_Y, static_cast<int16_t>(BAR_PITCH * static_cast<int32_t>(BUCKETS)),
+        static_cast<int16_t>(RANGE.y - 2 - HISTOGRAM_Y)};
+    static constexpr BoxRect BODY = layoutBody(PANEL_W, PANEL_H);
+
+    static_assert(BAR_W >= 1, "too many buckets for the panel width");
+    static_assert((ROW_CHARS * Font::CELL_W) <= PANEL_W, "stats rows do not fit the panel");
+    static_assert(BODY.y <= HEADER.y, "the stats rows run into the title");
+    static_assert(TREND.y + TREND.cellH < HISTOGRAM.y, "the trend row runs into the histogram");
+    static_assert(RANGE.y + RANGE.cellH <= PANEL_H, "the range row does not fit the panel");
+};
+
+// C++14 needs the static constexpr members defined outside the class
+template <int32_t W, int32_t H, typename F, typename D>
+constexpr TextBox StopwatchLayout<W, H, F, D>::STATE;
+template <int32_t W, int32_t H, typename F, typename D>
+constexpr TextBox StopwatchLayout<W, H, F, D>::TIME;
+template <int32_t W, int32_t H, typename F, typename D>
+constexpr TextBox StopwatchLayout<W, H, F, D>::LAP;
+template <int32_t W, int32_t H, typename F, typename D>
+constexpr BoxRect StopwatchLayout<W, H, F, D>::START_BUTTON;
+template <int32_t W, int32_t H, typename F, typename D>
+constexpr BoxRect StopwatchLayout<W, H, F, D>::RESET_BUTTON;
+template <int32_t W, int32_t H, typename F, typename D>
+constexpr BoxRect StopwatchLayout<W, H, F, D>::BODY;
+template <int32_t W, int32_t H, typename F, uint32_t B>
+constexpr TextBox LapStatsLayout<W, H, F, B>::HEADER;
+template <int32_t W, int32_t H, typename F, uint32_t B>
+constexpr TextBox LapStatsLayout<W, H, F, B>::MEAN;
+template <int32_t W, int32_t H, typename F, uint32_t B>
+constexpr TextBox LapStatsLayout<W, H, F, B>::SPREAD;
+template <int32_t W, int32_t H, typename F, uint32_t B>
+constexpr TextBox LapStatsLayout<W, H, F, B>::TREND;
+template <int32_t W, int32_t H, typename F, uint32_t B>
+constexpr TextBox LapStatsLayout<W, H, F, B>::RANGE;
+template <int32_t W, int32_t H, typename F, uint32_t B>
+constexpr BoxRect LapStatsLayout<W, H, F, B>::HISTOGRAM;
+template <int32_t W, int32_t H, typename F, uint32_t B>
+constexpr BoxRect LapStatsLayout<W, H, F, B>::BODY;
+
+#endif // SCREEN_LAYOUT_H_
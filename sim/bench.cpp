@@ -0,0 +1,382 @@
+// ============================================================================
+// Render-cost benchmark on the host simulation
+//
+// Boots the firmware exactly as main() does, then drives its main loop
+// through scripted scenarios (button presses, GPIO channel inputs, a
+// photogate, touches, the lap statistics page, idle time) on the virtual clock. For each scenario it reports what reached the
+// hardware boundary: GrLib calls and pixels, bytes on the LCD's SPI bus and
+// panel pixels written, per frame and in total. The "replay" scenario also
+// reports the input latency percentiles measured by latencyBench.h, and
+// "boot" how long after reset input was live and the display came on.
+//
+// Every count is deterministic, so CI can diff them against a baseline:
+//
+//   bench                     print the table
+//   bench --write FILE        also write "scenario.metric value" lines
+//   bench --check FILE        fail if any cost grew past FILE
+// ============================================================================
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#define main firmwareMain
+#include "../main.cpp"
+#undef main
+
+extern "C" {
+#include "driverlib/gpio.h"
+}
+
+#include "simCore.h"
+
+uint32_t simCycleCounter()
+{
+    return static_cast<uint32_t>(simCpuCycles());
+}
+
+struct Result {
+    std::string name;
+    uint64_t frames;
+    uint64_t buttonDraws;
+    uint64_t grCalls;
+    uint64_t grPixels;
+    uint64_t spiBytes;
+    uint64_t panelPixels;
+    uint64_t maxFrameGrPixels;
+};
+
+static std::vector<Result> sResults;
+static LatencySummary sLatency[LATENCY_METRICS];
+static bool sLatencyRan = false;
+
+// The "interleaved" scenario's outcome on CH1: the time it shows, and its
+// longest lap (an action applied out of order used to wrap either around)
+static uint32_t sInterleavedMs = 0;
+static uint32_t sInterleavedLapMs = 0;
+
+// Runs the firmware's main loop for 'ms' of virtual time and records the
+// work done under 'name'.
+static void runScenario(const char *name, uint32_t ms)
+{
+    const SimCounters before = gSimCounters;
+    const uint32_t frames0 = profilerStats(PROF_DRAW_SCREEN).count;
+    const uint32_t buttons0 = profilerStats(PROF_DRAW_BUTTON).count;
+    uint64_t maxFrame = 0U;
+
+    const uint64_t end = simNow() + simMsToTicks(ms);
+    do {
+        const uint32_t frames = profilerStats(PROF_DRAW_SCREEN).count;
+        const uint64_t pixels = gSimCounters.grPixels;
+        if (!gScheduler.dispatch()) {
+            gScheduler.idle();
+        }
+        if (profilerStats(PROF_DRAW_SCREEN).count != frames) {
+            const uint64_t framePixels = gSimCounters.grPixels - pixels;
+            maxFrame = (framePixels > maxFrame) ? framePixels : maxFrame;
+        }
+    } while (simNow() < end);
+
+    // Let DMA still in flight land so its bytes count for this scenario
+    simRunUntil(simNow() + simMsToTicks(20U));
+
+    Result r;
+    r.name = name;
+    r.frames = profilerStats(PROF_DRAW_SCREEN).count - frames0;
+    r.buttonDraws = profilerStats(PROF_DRAW_BUTTON).count - buttons0;
+    r.grCalls = gSimCounters.grCalls - before.grCalls;
+    r.grPixels = gSimCounters.grPixels - before.grPixels;
+    r.spiBytes = gSimCounters.spiBytes - before.spiBytes;
+    r.panelPixels = gSimCounters.panelPixels - before.panelPixels;
+    r.maxFrameGrPixels = maxFrame;
+    sResults.push_back(r);
+}
+
+// drawButton on its own, straight to the active display and flushed
+static void benchDrawButton(uint32_t calls)
+{
+    const SimCounters before = gSimCounters;
+    MyButton probe = {60, 80, 50, 28, "RESET", false};
+    for (uint32_t i = 0; i < calls; i++) {
+        probe.pressed = (i & 1U) != 0U;
+        drawButton(gContext, probe);
+#ifdef GrFlush
+        GrFlush(&gContext);
+#endif
+        simRunUntil(simNow() + simMsToTicks(5U));
+    }
+
+    Result r;
+    r.name = "drawButton";
+    r.frames = calls;
+    r.buttonDraws = calls;
+    r.grCalls = gSimCounters.grCalls - before.grCalls;
+    r.grPixels = gSimCounters.grPixels - before.grPixels;
+    r.spiBytes = gSimCounters.spiBytes - before.spiBytes;
+    r.panelPixels = gSimCounters.panelPixels - before.panelPixels;
+    r.maxFrameGrPixels = 0U;
+    sResults.push_back(r);
+
+    // Repaint the real buttons over the probe
+    gButtons.invalidate();
+}
+
+// LATENCY_TRACE through the real input path, as APP_LATENCY_BENCH does on
+// the target, with the report going out over the simulated UART
+static void benchLatencyReplay()
+{
+    const uint32_t endMs = LATENCY_TRACE[LATENCY_TRACE_LENGTH - 1U].atMs;
+    if (!startLatencyReplay()) {
+        return;
+    }
+    runScenario("replay", endMs + 2000U);
+    if (latencyReplayRunning()) {
+        return;
+    }
+    for (uint32_t m = 0; m < LATENCY_METRICS; m++) {
+        sLatency[m] = latencySummary(static_cast<LatencyMetric>(m));
+    }
+    latencyReport();
+    sLatencyRan = true;
+}
+
+static void press(uint32_t port, uint8_t pin, uint32_t atMs)
+{
+    simPressButton(port, pin, atMs, 80U);
+}
+
+static void runAll()
+{
+    initializeSystem();
+    runScenario("boot", 400U);   // the panel's power-up included
+    runScenario("idle_stopped", 2000U);
+
+    press(GPIO_PORTH_BASE, GPIO_PIN_1, 0U);   // S1: start
+    runScenario("running", 5000U);
+
+    for (uint32_t i = 0; i < 5U; i++) {
+        press(GPIO_PORTK_BASE, GPIO_PIN_6, i * 500U);   // S2: lap
+    }
+    runScenario("laps", 3000U);
+
+    press(GPIO_PORTH_BASE, GPIO_PIN_1, 0U);     // pause, once the double-click window closes
+    press(GPIO_PORTK_BASE, GPIO_PIN_6, 500U);   // reset
+    runScenario("pause_reset", 1000U);
+
+    benchLatencyReplay();
+
+    for (uint32_t i = 0; i < 8U; i++) {
+        simPressButton(GPIO_PORTM_BASE, static_cast<uint8_t>(1U << i), i * 50U, 40U);
+    }
+    runScenario("gpio_channels", 1000U);
+
+    for (uint32_t i = 0; i < STOPWATCH_CHANNELS; i++) {
+        press(GPIO_PORTJ_BASE, GPIO_PIN_0, i * 400U);   // USR_SW1: a click each, next channel
+    }
+    runScenario("page_channels", 3500U);
+
+    // Photogate on PL4: start, then a lap per beam break
+    for (uint32_t i = 0; i < 4U; i++) {
+        simPressButton(GPIO_PORTL_BASE, GPIO_PIN_4, i * 400U, 5U);
+    }
+    runScenario("gate_laps", 2000U);
+
+    // The on-screen buttons through the touch overlay: PLAY, then RESET
+    // to stop and clear as a long press
+    const BoxRect &play = SCREEN_BUTTONS[BTN_START].box;
+    const BoxRect &reset = SCREEN_BUTTONS[BTN_RESET].box;
+    simTouch(static_cast<int16_t>(play.x + play.w / 2), static_cast<int16_t>(play.y + play.h / 2),
+             0U, 80U);
+    simTouch(static_cast<int16_t>(reset.x + reset.w / 2), static_cast<int16_t>(reset.y + reset.h / 2),
+             1000U, 1000U);
+    runScenario("touch", 2500U);
+
+    // Holding USR_SW1 opens CH1's lap statistics while it runs; each S2 lap
+    // then moves one histogram bar. Held again, back to the stopwatch.
+    press(GPIO_PORTH_BASE, GPIO_PIN_1, 0U);   // S1: start
+    simPressButton(GPIO_PORTJ_BASE, GPIO_PIN_0, 300U, 1000U);
+    static const uint32_t LAP_AT_MS[] = {600U, 1160U, 1800U, 2380U, 2990U, 3580U};
+    for (uint32_t at : LAP_AT_MS) {
+        press(GPIO_PORTK_BASE, GPIO_PIN_6, at);   // S2: lap
+    }
+    simPressButton(GPIO_PORTJ_BASE, GPIO_PIN_0, 4000U, 1000U);
+    runScenario("lap_stats", 5500U);
+
+    // Other inputs inside S1's double-click window, each acting on the
+    // state as it is when pressed: S1 starts, S2 and the photogate lap
+    // before its window closes; an S1 double click laps; S1 stops. Then an
+    // S1 start with an S2 lap before the second press, which is a click of
+    // its own and stops. CH1 runs 1500..3400 and 3800..4000 ms (2100 ms of
+    // channel time); the longest lap is the S2 one at 3900 ms (1000 ms).
+    simPressButton(GPIO_PORTK_BASE, GPIO_PIN_6, 0U, 1000U);   // S2 held: stop and reset
+    press(GPIO_PORTH_BASE, GPIO_PIN_1, 1500U);
+    press(GPIO_PORTK_BASE, GPIO_PIN_6, 1600U);
+    simPressButton(GPIO_PORTL_BASE, GPIO_PIN_4, 1700U, 5U);
+    press(GPIO_PORTH_BASE, GPIO_PIN_1, 2500U);
+    press(GPIO_PORTH_BASE, GPIO_PIN_1, 2650U);
+    press(GPIO_PORTH_BASE, GPIO_PIN_1, 3400U);
+    press(GPIO_PORTH_BASE, GPIO_PIN_1, 3800U);
+    press(GPIO_PORTK_BASE, GPIO_PIN_6, 3900U);
+    press(GPIO_PORTH_BASE, GPIO_PIN_1, 4000U);
+    runScenario("interleaved", 4500U);
+    sInterleavedMs = Stopwatch(0).elapsedMs();
+    for (uint32_t i = 0; i < gLaps[0].stored(); i++) {
+        const uint32_t ms = static_cast<uint32_t>(timebaseTicksToMs(gLaps[0].recent(i).lapTicks));
+        sInterleavedLapMs = (ms > sInterleavedLapMs) ? ms : sInterleavedLapMs;
+    }
+
+    benchDrawButton(100U);
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+static double perFrame(uint64_t total, uint64_t frames)
+{
+    return (frames > 0U) ? static_cast<double>(total) / static_cast<double>(frames) : 0.0;
+}
+
+// Boot milestone 'stage' in us after reset (the clock is set at reset here)
+static uint64_t bootUs(uint32_t stage)
+{
+    return gBootCycles[stage] / (SYSTEM_CLOCK_HZ / 1000000U);
+}
+
+static void printTable()
+{
+    printf("%-14s %7s %8s %10s %10s %10s %12s %11s\n", "scenario", "frames", "buttons",
+           "gr_calls/f", "gr_px/f", "spi_B/f", "panel_px/f", "max_gr_px/f");
+    for (const Result &r : sResults) {
+        printf("%-14s %7llu %8llu %10.1f %10.1f %10.1f %12.1f %11llu\n", r.name.c_str(),
+               static_cast<unsigned long long>(r.frames),
+               static_cast<unsigned long long>(r.buttonDraws),
+               perFrame(r.grCalls, r.frames), perFrame(r.grPixels, r.frames),
+               perFrame(r.spiBytes, r.frames), perFrame(r.panelPixels, r.frames),
+               static_cast<unsigned long long>(r.maxFrameGrPixels));
+    }
+    printf("\nboot: input ready %.3f ms, display on %.3f ms\n", bootUs(BOOT_INPUT_READY) / 1000.0,
+           bootUs(BOOT_DISPLAY_ON) / 1000.0);
+
+    if (!sLatencyRan) {
+        printf("\nlatency replay did not finish\n");
+        return;
+    }
+    static const char *const names[LATENCY_METRICS] = {"edge->state", "edge->pixels"};
+    printf("\n%-14s %7s %10s %10s %10s %10s\n", "latency", "count", "p50_ms", "p90_ms",
+           "p99_ms", "max_ms");
+    for (uint32_t m = 0; m < LATENCY_METRICS; m++) {
+        const LatencySummary &s = sLatency[m];
+        printf("%-14s %7u %10.3f %10.3f %10.3f %10.3f\n", names[m], static_cast<unsigned>(s.count),
+               s.p50Us / 1000.0, s.p90Us / 1000.0, s.p99Us / 1000.0, s.maxUs / 1000.0);
+    }
+}
+
+static std::map<std::string, uint64_t> metrics()
+{
+    std::map<std::string, uint64_t> m;
+    for (const Result &r : sResults) {
+        m[r.name + ".frames"] = r.frames;
+        m[r.name + ".button_draws"] = r.buttonDraws;
+        m[r.name + ".gr_calls"] = r.grCalls;
+        m[r.name + ".gr_pixels"] = r.grPixels;
+        m[r.name + ".spi_bytes"] = r.spiBytes;
+        m[r.name + ".panel_pixels"] = r.panelPixels;
+        m[r.name + ".max_frame_gr_pixels"] = r.maxFrameGrPixels;
+    }
+    m["boot.input_ready_us"] = bootUs(BOOT_INPUT_READY);
+    m["boot.display_on_us"] = bootUs(BOOT_DISPLAY_ON);
+    m["interleaved.channel_ms"] = sInterleavedMs;
+    m["interleaved.longest_lap_ms"] = sInterleavedLapMs;
+    if (sLatencyRan) {
+        static const char *const names[LATENCY_METRICS] = {"state", "pixels"};
+        for (uint32_t i = 0; i < LATENCY_METRICS; i++) {
+            const std::string key = std::string("latency.") + names[i];
+            const LatencySummary &s = sLatency[i];
+            m[key + ".frames"] = s.count;   // a count, not gated
+            m[key + ".p50_us"] = s.p50Us;
+            m[key + ".p90_us"] = s.p90Us;
+            m[key + ".p99_us"] = s.p99Us;
+            m[key + ".max_us"] = s.maxUs;
+        }
+    }
+    return m;
+}
+
+static bool writeMetrics(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (f == nullptr) {
+        perror(path);
+        return false;
+    }
+    for (const auto &kv : metrics()) {
+        fprintf(f, "%s %llu\n", kv.first.c_str(), static_cast<unsigned long long>(kv.second));
+    }
+    fclose(f);
+    return true;
+}
+
+// Frame counts depend on the governor and are reported, not gated. Every
+// cost metric must stay within CHECK_SLACK_PCT of the baseline: a cheaper
+// frame can shift the pacing by a frame or a strip, which is not a
+// regression.
+static constexpr uint64_t CHECK_SLACK_PCT = 1U;
+
+static bool checkMetrics(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (f == nullptr) {
+        perror(path);
+        return false;
+    }
+    const std::map<std::string, uint64_t> now = metrics();
+    bool ok = true;
+    char key[128];
+    unsigned long long expected;
+    while (fscanf(f, "%127s %llu", key, &expected) == 2) {
+        const auto it = now.find(key);
+        if (it == now.end()) {
+            printf("missing  %s (baseline %llu)\n", key, expected);
+            ok = false;
+            continue;
+        }
+        if (strstr(key, ".frames") != nullptr) {
+            continue;
+        }
+        if (it->second * 100U > expected * (100U + CHECK_SLACK_PCT)) {
+            printf("REGRESSED %s: %llu -> %llu\n", key, expected,
+                   static_cast<unsigned long long>(it->second));
+            ok = false;
+        } else if (it->second < expected) {
+            printf("improved  %s: %llu -> %llu\n", key, expected,
+                   static_cast<unsigned long long>(it->second));
+        }
+    }
+    fclose(f);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    runAll();
+    printTable();
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--write") == 0) {
+            if (!writeMetrics(argv[i + 1])) {
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--check") == 0) {
+            if (!checkMetrics(argv[i + 1])) {
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "usage: %s [--write FILE] [--check FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+    return 0;
+}
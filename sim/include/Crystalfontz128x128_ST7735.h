@@ -0,0 +1,25 @@
+// Host simulation stand-in for the Crystalfontz 128x128 ST7735 GrLib driver
+#ifndef SIM_CRYSTALFONTZ128X128_ST7735_H_
+#define SIM_CRYSTALFONTZ128X128_ST7735_H_
+
+#include <stdint.h>
+
+#include "grlib/grlib.h"
+
+#define LCD_ORIENTATION_UP      0
+#define LCD_ORIENTATION_LEFT    1
+#define LCD_ORIENTATION_DOWN    2
+#define LCD_ORIENTATION_RIGHT   3
+
+// ST7735 commands
+#define CM_CASET                0x2A
+#define CM_RASET                0x2B
+#define CM_RAMWR                0x2C
+
+extern const tDisplay g_sCrystalfontz128x128;
+
+void Crystalfontz128x128_Init(void);
+void Crystalfontz128x128_SetOrientation(uint8_t orientation);
+void Crystalfontz128x128_SetDrawFrame(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+
+#endif // SIM_CRYSTALFONTZ128X128_ST7735_H_
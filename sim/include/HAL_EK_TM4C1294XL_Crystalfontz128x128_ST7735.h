@@ -0,0 +1,15 @@
+// Host simulation stand-in for the LCD BoosterPack HAL (EK-TM4C1294XL)
+#ifndef SIM_HAL_EK_TM4C1294XL_CRYSTALFONTZ128X128_ST7735_H_
+#define SIM_HAL_EK_TM4C1294XL_CRYSTALFONTZ128X128_ST7735_H_
+
+#include <stdint.h>
+
+// Pins (reset, D/C, chip select, SPI) and the SSI master
+void HAL_LCD_PortInit(void);
+void HAL_LCD_SpiInit(void);
+
+// Blocking single-byte SPI writes with D/C low (command) or high (data)
+void HAL_LCD_writeCommand(uint8_t command);
+void HAL_LCD_writeData(uint8_t data);
+
+#endif // SIM_HAL_EK_TM4C1294XL_CRYSTALFONTZ128X128_ST7735_H_
@@ -0,0 +1,37 @@
+// Host simulation stand-in for the course Button library (polled, debounced)
+#ifndef SIM_BUTTON_H_
+#define SIM_BUTTON_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Board buttons
+enum ButtonPin { S1, S2 };
+
+class Button {
+public:
+    explicit Button(ButtonPin pin);
+
+    void begin();
+    void setTickIntervalMs(uint32_t ms);
+    void setDebounceMs(uint32_t ms);
+    void tick();
+
+    bool wasPressed();
+    bool wasReleased();
+    bool isPressed() const { return m_pressed; }
+
+private:
+    bool readPressed() const;
+
+    uint32_t m_port;
+    uint8_t m_pin;
+    uint32_t m_tickMs;
+    uint32_t m_debounceMs;
+    uint32_t m_stableMs;
+    bool m_pressed;
+    bool m_pressEvent;
+    bool m_releaseEvent;
+};
+
+#endif // SIM_BUTTON_H_
@@ -0,0 +1,10 @@
+// Host simulation stand-in for TivaWare driverlib/cpu.h
+#ifndef SIM_DRIVERLIB_CPU_H_
+#define SIM_DRIVERLIB_CPU_H_
+
+#include <stdint.h>
+
+// Sleeps until the next simulated interrupt (advances the virtual clock)
+void CPUwfi(void);
+
+#endif // SIM_DRIVERLIB_CPU_H_
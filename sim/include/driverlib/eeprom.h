@@ -0,0 +1,16 @@
+// Host simulation stand-in for TivaWare driverlib/eeprom.h
+#ifndef SIM_DRIVERLIB_EEPROM_H_
+#define SIM_DRIVERLIB_EEPROM_H_
+
+#include <stdint.h>
+
+#define EEPROM_INIT_OK          0
+#define EEPROM_RC_WORKING       0x00000001
+
+uint32_t EEPROMInit(void);
+uint32_t EEPROMSizeGet(void);
+void EEPROMRead(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count);
+uint32_t EEPROMProgramNonBlocking(uint32_t ui32Data, uint32_t ui32Address);
+uint32_t EEPROMStatusGet(void);
+
+#endif // SIM_DRIVERLIB_EEPROM_H_
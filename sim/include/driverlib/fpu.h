@@ -0,0 +1,8 @@
+// Host simulation stand-in for TivaWare driverlib/fpu.h
+#ifndef SIM_DRIVERLIB_FPU_H_
+#define SIM_DRIVERLIB_FPU_H_
+
+void FPUEnable(void);
+void FPULazyStackingEnable(void);
+
+#endif // SIM_DRIVERLIB_FPU_H_
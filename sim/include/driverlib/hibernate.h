@@ -0,0 +1,18 @@
+// Host simulation stand-in for TivaWare driverlib/hibernate.h
+#ifndef SIM_DRIVERLIB_HIBERNATE_H_
+#define SIM_DRIVERLIB_HIBERNATE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HIBERNATE_OSC_LOWDRIVE  0x00000000
+
+void HibernateEnableExpClk(uint32_t ui32HibClk);
+void HibernateClockConfig(uint32_t ui32Config);
+bool HibernateIsActive(void);
+void HibernateRTCEnable(void);
+uint32_t HibernateRTCGet(void);
+uint32_t HibernateRTCSSGet(void);
+void HibernateDataGet(uint32_t *pui32Data, uint32_t ui32Count);
+
+#endif // SIM_DRIVERLIB_HIBERNATE_H_
@@ -0,0 +1,16 @@
+// Host simulation stand-in for TivaWare driverlib/interrupt.h
+#ifndef SIM_DRIVERLIB_INTERRUPT_H_
+#define SIM_DRIVERLIB_INTERRUPT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+bool IntMasterEnable(void);
+bool IntMasterDisable(void);
+void IntRegister(uint32_t ui32Interrupt, void (*pfnHandler)(void));
+void IntEnable(uint32_t ui32Interrupt);
+void IntDisable(uint32_t ui32Interrupt);
+void IntPrioritySet(uint32_t ui32Interrupt, uint8_t ui8Priority);
+void IntPendSet(uint32_t ui32Interrupt);
+
+#endif // SIM_DRIVERLIB_INTERRUPT_H_
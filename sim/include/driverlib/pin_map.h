@@ -0,0 +1,8 @@
+// Host simulation stand-in for TivaWare driverlib/pin_map.h
+#ifndef SIM_DRIVERLIB_PIN_MAP_H_
+#define SIM_DRIVERLIB_PIN_MAP_H_
+
+#define GPIO_PA0_U0RX 0x00000001
+#define GPIO_PA1_U0TX 0x00000401
+
+#endif // SIM_DRIVERLIB_PIN_MAP_H_
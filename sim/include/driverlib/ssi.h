@@ -0,0 +1,23 @@
+// Host simulation stand-in for TivaWare driverlib/ssi.h
+#ifndef SIM_DRIVERLIB_SSI_H_
+#define SIM_DRIVERLIB_SSI_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SSI_DMATX               0x00000020
+#define SSI_DMA_TX              0x00000002
+#define SSI_FRF_MOTO_MODE_0     0x00000000
+#define SSI_MODE_MASTER         0x00000000
+
+void SSIIntRegister(uint32_t ui32Base, void (*pfnHandler)(void));
+void SSIIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags);
+void SSIIntClear(uint32_t ui32Base, uint32_t ui32IntFlags);
+void SSIDMAEnable(uint32_t ui32Base, uint32_t ui32DMAFlags);
+bool SSIBusy(uint32_t ui32Base);
+void SSIEnable(uint32_t ui32Base);
+void SSIDisable(uint32_t ui32Base);
+void SSIConfigSetExpClk(uint32_t ui32Base, uint32_t ui32SSIClk, uint32_t ui32Protocol,
+                        uint32_t ui32Mode, uint32_t ui32BitRate, uint32_t ui32DataWidth);
+
+#endif // SIM_DRIVERLIB_SSI_H_
@@ -0,0 +1,45 @@
+// Host simulation stand-in for TivaWare driverlib/sysctl.h
+#ifndef SIM_DRIVERLIB_SYSCTL_H_
+#define SIM_DRIVERLIB_SYSCTL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SYSCTL_XTAL_25MHZ       0x00000000
+#define SYSCTL_OSC_MAIN         0x00000000
+#define SYSCTL_OSC_INT          0x00000010
+#define SYSCTL_USE_PLL          0x00000000
+#define SYSCTL_USE_OSC          0x00003800
+#define SYSCTL_CFG_VCO_480      0xF1000000
+#define SYSCTL_CFG_VCO_320      0xF0000000
+
+#define SYSCTL_PERIPH_WDOG0     0xf0000000
+#define SYSCTL_PERIPH_WDOG1     0xf0000001
+#define SYSCTL_PERIPH_TIMER0    0xf0000400
+#define SYSCTL_PERIPH_TIMER1    0xf0000401
+#define SYSCTL_PERIPH_TIMER2    0xf0000402
+#define SYSCTL_PERIPH_TIMER3    0xf0000403
+#define SYSCTL_PERIPH_GPIOA     0xf0000800
+#define SYSCTL_PERIPH_GPIOD     0xf0000803
+#define SYSCTL_PERIPH_GPIOH     0xf0000807
+#define SYSCTL_PERIPH_GPIOJ     0xf0000808
+#define SYSCTL_PERIPH_GPIOK     0xf0000809
+#define SYSCTL_PERIPH_GPIOL     0xf000080a
+#define SYSCTL_PERIPH_GPIOM     0xf000080b
+#define SYSCTL_PERIPH_UDMA      0xf0000c00
+#define SYSCTL_PERIPH_UART0     0xf0001800
+#define SYSCTL_PERIPH_SSI2      0xf0001c02
+#define SYSCTL_PERIPH_SSI3      0xf0001c03
+#define SYSCTL_PERIPH_EEPROM0   0xf0005800
+#define SYSCTL_PERIPH_HIBERNATE 0xf0009c00
+
+uint32_t SysCtlClockFreqSet(uint32_t ui32Config, uint32_t ui32SysClock);
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral);
+void SysCtlPeripheralDisable(uint32_t ui32Peripheral);
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral);
+void SysCtlPeripheralSleepEnable(uint32_t ui32Peripheral);
+void SysCtlPeripheralClockGating(bool bEnable);
+void SysCtlSleep(void);
+void SysCtlDelay(uint32_t ui32Count);
+
+#endif // SIM_DRIVERLIB_SYSCTL_H_
@@ -0,0 +1,27 @@
+// Host simulation stand-in for TivaWare driverlib/uart.h
+#ifndef SIM_DRIVERLIB_UART_H_
+#define SIM_DRIVERLIB_UART_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define UART_CONFIG_WLEN_8      0x00000060
+#define UART_CONFIG_STOP_ONE    0x00000000
+#define UART_CONFIG_PAR_NONE    0x00000000
+
+#define UART_INT_DMATX          0x00020000
+#define UART_DMA_TX             0x00000002
+
+void UARTConfigSetExpClk(uint32_t ui32Base, uint32_t ui32UARTClk, uint32_t ui32Baud,
+                         uint32_t ui32Config);
+void UARTFIFOEnable(uint32_t ui32Base);
+void UARTDMAEnable(uint32_t ui32Base, uint32_t ui32DMAFlags);
+void UARTIntRegister(uint32_t ui32Base, void (*pfnHandler)(void));
+void UARTIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags);
+void UARTIntClear(uint32_t ui32Base, uint32_t ui32IntFlags);
+void UARTCharPut(uint32_t ui32Base, unsigned char ucData);
+bool UARTCharsAvail(uint32_t ui32Base);
+int32_t UARTCharGetNonBlocking(uint32_t ui32Base);
+bool UARTBusy(uint32_t ui32Base);
+
+#endif // SIM_DRIVERLIB_UART_H_
@@ -0,0 +1,43 @@
+// Host simulation stand-in for TivaWare driverlib/udma.h
+#ifndef SIM_DRIVERLIB_UDMA_H_
+#define SIM_DRIVERLIB_UDMA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    volatile void *pvSrcEndAddr;
+    volatile void *pvDstEndAddr;
+    volatile uint32_t ui32Control;
+    volatile uint32_t ui32Spare;
+} tDMAControlTable;
+
+#define UDMA_PRI_SELECT         0x00000000
+#define UDMA_ALT_SELECT         0x00000020
+
+#define UDMA_MODE_BASIC         0x00000001
+
+#define UDMA_SIZE_8             0x00000000
+#define UDMA_SRC_INC_8          0x00000000
+#define UDMA_SRC_INC_NONE       0x0c000000
+#define UDMA_DST_INC_NONE       0xc0000000
+#define UDMA_ARB_4              0x00008000
+
+#define UDMA_ATTR_USEBURST      0x00000001
+#define UDMA_ATTR_ALL           0x0000000F
+
+#define UDMA_CH9_UART0TX        0x00000009
+#define UDMA_CH13_SSI2TX        0x0002000D
+
+void uDMAEnable(void);
+void uDMAControlBaseSet(void *pControlTable);
+void uDMAChannelAssign(uint32_t ui32Mapping);
+void uDMAChannelAttributeEnable(uint32_t ui32ChannelNum, uint32_t ui32Attr);
+void uDMAChannelAttributeDisable(uint32_t ui32ChannelNum, uint32_t ui32Attr);
+void uDMAChannelControlSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Control);
+void uDMAChannelTransferSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Mode,
+                            void *pvSrcAddr, void *pvDstAddr, uint32_t ui32TransferSize);
+void uDMAChannelEnable(uint32_t ui32ChannelNum);
+bool uDMAChannelIsEnabled(uint32_t ui32ChannelNum);
+
+#endif // SIM_DRIVERLIB_UDMA_H_
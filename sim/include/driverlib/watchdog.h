@@ -0,0 +1,13 @@
+// Host simulation stand-in for TivaWare driverlib/watchdog.h
+#ifndef SIM_DRIVERLIB_WATCHDOG_H_
+#define SIM_DRIVERLIB_WATCHDOG_H_
+
+#include <stdint.h>
+
+void WatchdogReloadSet(uint32_t ui32Base, uint32_t ui32LoadVal);
+void WatchdogResetEnable(uint32_t ui32Base);
+void WatchdogStallEnable(uint32_t ui32Base);
+void WatchdogEnable(uint32_t ui32Base);
+void WatchdogIntClear(uint32_t ui32Base);
+
+#endif // SIM_DRIVERLIB_WATCHDOG_H_
@@ -0,0 +1,26 @@
+// Host simulation stand-in for the course elapsedTime library
+#ifndef SIM_ELAPSED_TIME_H_
+#define SIM_ELAPSED_TIME_H_
+
+#include <stdint.h>
+
+#include "timerLib.h"
+
+// Milliseconds since construction or the last assignment
+class elapsedMillis {
+public:
+    explicit elapsedMillis(Timer &timer) : m_timer(&timer), m_start(timer.millis()) {}
+
+    operator uint32_t() const { return m_timer->millis() - m_start; }
+    elapsedMillis &operator=(uint32_t ms)
+    {
+        m_start = m_timer->millis() - ms;
+        return *this;
+    }
+
+private:
+    Timer *m_timer;
+    uint32_t m_start;
+};
+
+#endif // SIM_ELAPSED_TIME_H_
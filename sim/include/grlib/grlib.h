@@ -0,0 +1,107 @@
+// Host simulation stand-in for TivaWare grlib/grlib.h
+//
+// The subset of GrLib the firmware uses, with the same types, macros and
+// display-driver callback contract. String rendering goes through the
+// display's pfnPixelDrawMultiple one glyph row at a time, like the real
+// library's fixed-width path.
+#ifndef SIM_GRLIB_GRLIB_H_
+#define SIM_GRLIB_GRLIB_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    int16_t i16XMin;
+    int16_t i16YMin;
+    int16_t i16XMax;
+    int16_t i16YMax;
+} tRectangle;
+
+typedef struct {
+    int32_t i32Size;
+    void *pvDisplayData;
+    uint16_t ui16Width;
+    uint16_t ui16Height;
+    void (*pfnPixelDraw)(void *pvDisplayData, int32_t i32X, int32_t i32Y, uint32_t ui32Value);
+    void (*pfnPixelDrawMultiple)(void *pvDisplayData, int32_t i32X, int32_t i32Y,
+                                 int32_t i32X0, int32_t i32Count, int32_t i32BPP,
+                                 const uint8_t *pui8Data, const uint8_t *pui8Palette);
+    void (*pfnLineDrawH)(void *pvDisplayData, int32_t i32X1, int32_t i32X2, int32_t i32Y,
+                         uint32_t ui32Value);
+    void (*pfnLineDrawV)(void *pvDisplayData, int32_t i32X, int32_t i32Y1, int32_t i32Y2,
+                         uint32_t ui32Value);
+    void (*pfnRectFill)(void *pvDisplayData, const tRectangle *psRect, uint32_t ui32Value);
+    uint32_t (*pfnColorTranslate)(void *pvDisplayData, uint32_t ui32Value);
+    void (*pfnFlush)(void *pvDisplayData);
+} tDisplay;
+
+// Fixed-width 1 bpp font: one byte per glyph row, MSB = leftmost column
+typedef struct {
+    uint8_t ui8Format;
+    uint8_t ui8MaxWidth;
+    uint8_t ui8Height;
+    uint8_t ui8Baseline;
+    uint8_t ui8First;          // first character code in pui8Data
+    uint8_t ui8Last;           // last character code in pui8Data
+    const uint8_t *pui8Data;   // ui8Height bytes per glyph
+} tFont;
+
+typedef struct {
+    int32_t i32Size;
+    const tDisplay *psDisplay;
+    tRectangle sClipRegion;
+    uint32_t ui32Foreground;
+    uint32_t ui32Background;
+    const tFont *psFont;
+} tContext;
+
+#define ClrBlack                0x00000000
+#define ClrNavy                 0x00000080
+#define ClrBlue                 0x000000FF
+#define ClrDarkGreen            0x00006400
+#define ClrGreen                0x00008000
+#define ClrDarkCyan             0x00008B8B
+#define ClrCyan                 0x0000FFFF
+#define ClrLime                 0x0000FF00
+#define ClrDimGray              0x00696969
+#define ClrGray                 0x00808080
+#define ClrOlive                0x00808000
+#define ClrDarkRed              0x008B0000
+#define ClrDarkGray             0x00A9A9A9
+#define ClrSilver               0x00C0C0C0
+#define ClrRed                  0x00FF0000
+#define ClrMagenta              0x00FF00FF
+#define ClrDarkOrange           0x00FF8C00
+#define ClrOrange               0x00FFA500
+#define ClrYellow               0x00FFFF00
+#define ClrWhite                0x00FFFFFF
+
+extern const tFont g_sFontFixed6x8;
+
+void GrContextInit(tContext *psContext, const tDisplay *psDisplay);
+
+#define GrContextForegroundSet(c, v) \
+    ((c)->ui32Foreground = (c)->psDisplay->pfnColorTranslate((c)->psDisplay->pvDisplayData, (v)))
+#define GrContextBackgroundSet(c, v) \
+    ((c)->ui32Background = (c)->psDisplay->pfnColorTranslate((c)->psDisplay->pvDisplayData, (v)))
+#define GrContextFontSet(c, f) ((c)->psFont = (f))
+#define GrFlush(c) ((c)->psDisplay->pfnFlush((c)->psDisplay->pvDisplayData))
+
+void GrPixelDraw(const tContext *psContext, int32_t i32X, int32_t i32Y);
+void GrLineDrawH(const tContext *psContext, int32_t i32X1, int32_t i32X2, int32_t i32Y);
+void GrLineDrawV(const tContext *psContext, int32_t i32X, int32_t i32Y1, int32_t i32Y2);
+void GrRectDraw(const tContext *psContext, const tRectangle *psRect);
+void GrRectFill(const tContext *psContext, const tRectangle *psRect);
+void GrStringDraw(const tContext *psContext, const char *pcString, int32_t i32Length,
+                  int32_t i32X, int32_t i32Y, uint32_t bOpaque);
+int32_t GrStringWidthGet(const tContext *psContext, const char *pcString, int32_t i32Length);
+
+#define GrStringHeightGet(c) ((c)->psFont->ui8Height)
+#define GrFontHeightGet(f) ((f)->ui8Height)
+#define GrFontMaxWidthGet(f) ((f)->ui8MaxWidth)
+#define GrFontBaselineGet(f) ((f)->ui8Baseline)
+#define GrStringDrawCentered(c, s, l, x, y, o)                                     \
+    GrStringDraw((c), (s), (l), (x) - GrStringWidthGet((c), (s), (l)) / 2,         \
+                 (y) - GrFontBaselineGet((c)->psFont) / 2, (o))
+
+#endif // SIM_GRLIB_GRLIB_H_
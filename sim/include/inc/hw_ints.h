@@ -0,0 +1,23 @@
+// Host simulation stand-in for TivaWare inc/hw_ints.h (TM4C129 vectors)
+#ifndef SIM_INC_HW_INTS_H_
+#define SIM_INC_HW_INTS_H_
+
+#define INT_GPIOA               16
+#define INT_GPIOD               19
+#define INT_UART0               21
+#define INT_TIMER0A             35
+#define INT_TIMER1A             37
+#define INT_TIMER2A             39
+#define INT_GPIOH               48
+#define INT_TIMER3A             51
+#define INT_HIBERNATE           59
+#define INT_GPIOJ               67
+#define INT_GPIOK               68
+#define INT_GPIOL               69
+#define INT_SSI2                70
+#define INT_SSI3                71
+#define INT_GPIOM               88
+
+#define NUM_INTERRUPTS          130
+
+#endif // SIM_INC_HW_INTS_H_
@@ -0,0 +1,23 @@
+// Host simulation stand-in for TivaWare inc/hw_memmap.h (TM4C1294)
+#ifndef SIM_INC_HW_MEMMAP_H_
+#define SIM_INC_HW_MEMMAP_H_
+
+#define WATCHDOG1_BASE          0x40001000
+#define SSI2_BASE               0x4000A000
+#define SSI3_BASE               0x4000B000
+#define UART0_BASE              0x4000C000
+#define TIMER0_BASE             0x40030000
+#define TIMER1_BASE             0x40031000
+#define TIMER2_BASE             0x40032000
+#define TIMER3_BASE             0x40033000
+#define GPIO_PORTA_BASE         0x40058000
+#define GPIO_PORTD_BASE         0x4005B000
+#define GPIO_PORTH_BASE         0x4005F000
+#define GPIO_PORTJ_BASE         0x40060000
+#define GPIO_PORTK_BASE         0x40061000
+#define GPIO_PORTL_BASE         0x40062000
+#define GPIO_PORTM_BASE         0x40063000
+#define EEPROM_BASE             0x400AF000
+#define HIB_BASE                0x400FC000
+
+#endif // SIM_INC_HW_MEMMAP_H_
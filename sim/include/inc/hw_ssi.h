@@ -0,0 +1,7 @@
+// Host simulation stand-in for TivaWare inc/hw_ssi.h
+#ifndef SIM_INC_HW_SSI_H_
+#define SIM_INC_HW_SSI_H_
+
+#define SSI_O_DR                0x00000008
+
+#endif // SIM_INC_HW_SSI_H_
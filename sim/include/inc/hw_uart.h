@@ -0,0 +1,7 @@
+// Host simulation stand-in for TivaWare inc/hw_uart.h
+#ifndef SIM_INC_HW_UART_H_
+#define SIM_INC_HW_UART_H_
+
+#define UART_O_DR               0x00000000
+
+#endif // SIM_INC_HW_UART_H_
@@ -0,0 +1,5 @@
+// Host simulation stand-in for sysctl_pll.h (nothing is used from it)
+#ifndef SIM_SYSCTL_PLL_H_
+#define SIM_SYSCTL_PLL_H_
+
+#endif // SIM_SYSCTL_PLL_H_
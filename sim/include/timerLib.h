@@ -0,0 +1,14 @@
+// Host simulation stand-in for the course timerLib: millisecond time base
+// read from the simulated clock
+#ifndef SIM_TIMER_LIB_H_
+#define SIM_TIMER_LIB_H_
+
+#include <stdint.h>
+
+class Timer {
+public:
+    void begin(uint32_t sysClock, uint32_t timerBase);
+    uint32_t millis() const;
+};
+
+#endif // SIM_TIMER_LIB_H_
@@ -0,0 +1,269 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <vector>
+
+extern "C" {
+#include "driverlib/cpu.h"
+#include "driverlib/fpu.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "inc/hw_ints.h"
+}
+
+#include "simCore.h"
+
+SimCounters gSimCounters = {};
+
+static uint64_t sNow = 0;
+static uint32_t sClockHz = 16000000U;   // PIOSC until SysCtlClockFreqSet
+static uint32_t sTicksPerCycle = SIM_TICK_HZ / 16000000U;
+static uint64_t sCycleBase = 0;         // CPU cycles at the last clock switch
+static uint64_t sCycleBaseTick = 0;     // and the tick it happened at
+
+struct Event {
+    uint64_t tick;
+    uint32_t handle;
+    SimEventFn fn;
+    uint32_t arg;
+};
+static std::vector<Event> sEvents;
+static uint32_t sNextHandle = 1U;
+
+struct Vector {
+    void (*handler)();
+    uint8_t priority;
+    bool enabled;
+    bool pending;
+};
+static Vector sVectors[NUM_INTERRUPTS] = {};
+static bool sMasterEnabled = false;
+static bool sInHandler = false;
+static uint64_t sHandlerRuns = 0;
+
+// ============================================================================
+// Clock and events
+// ============================================================================
+uint64_t simNow()
+{
+    return sNow;
+}
+
+uint32_t simClockHz()
+{
+    return sClockHz;
+}
+
+uint64_t simCpuCycles()
+{
+    return sCycleBase + ((sNow - sCycleBaseTick) / sTicksPerCycle);
+}
+
+uint64_t simMsToTicks(uint32_t ms)
+{
+    return static_cast<uint64_t>(ms) * (SIM_TICK_HZ / 1000U);
+}
+
+uint32_t simTicksToMs(uint64_t ticks)
+{
+    return static_cast<uint32_t>(ticks / (SIM_TICK_HZ / 1000U));
+}
+
+uint64_t simTicksAfterCycles(uint64_t cycles)
+{
+    return sNow + (cycles * sTicksPerCycle);
+}
+
+uint32_t simSchedule(uint64_t tick, SimEventFn fn, uint32_t arg)
+{
+    const Event e = {tick, sNextHandle++, fn, arg};
+    sEvents.push_back(e);
+    return e.handle;
+}
+
+void simCancel(uint32_t handle)
+{
+    for (size_t i = 0; i < sEvents.size(); i++) {
+        if (sEvents[i].handle == handle) {
+            sEvents.erase(sEvents.begin() + static_cast<long>(i));
+            return;
+        }
+    }
+}
+
+// Earliest event; ties go in scheduling order
+static int32_t nextEvent()
+{
+    int32_t best = -1;
+    for (size_t i = 0; i < sEvents.size(); i++) {
+        if ((best < 0) || (sEvents[i].tick < sEvents[static_cast<size_t>(best)].tick)) {
+            best = static_cast<int32_t>(i);
+        }
+    }
+    return best;
+}
+
+bool simStep(uint64_t limit)
+{
+    const int32_t i = nextEvent();
+    if ((i < 0) || (sEvents[static_cast<size_t>(i)].tick > limit)) {
+        return false;
+    }
+    const Event e = sEvents[static_cast<size_t>(i)];
+    sEvents.erase(sEvents.begin() + i);
+    if (e.tick > sNow) {
+        sNow = e.tick;
+    }
+    e.fn(e.arg);
+    simDeliverInterrupts();
+    return true;
+}
+
+void simRunUntil(uint64_t tick)
+{
+    while (simStep(tick)) {
+    }
+    if (tick > sNow) {
+        sNow = tick;
+    }
+}
+
+// ============================================================================
+// Interrupts
+// ============================================================================
+void simRaise(uint32_t vector)
+{
+    if (vector < NUM_INTERRUPTS) {
+        sVectors[vector].pending = true;
+    }
+}
+
+bool simAnyPending()
+{
+    for (uint32_t v = 0; v < NUM_INTERRUPTS; v++) {
+        if (sVectors[v].pending && sVectors[v].enabled) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void simDeliverInterrupts()
+{
+    while (sMasterEnabled && !sInHandler) {
+        int32_t best = -1;
+        for (uint32_t v = 0; v < NUM_INTERRUPTS; v++) {
+            const Vector &vec = sVectors[v];
+            if (!vec.pending || !vec.enabled || (vec.handler == nullptr)) {
+                continue;
+            }
+            if ((best < 0) || (vec.priority < sVectors[best].priority)) {
+                best = static_cast<int32_t>(v);
+            }
+        }
+        if (best < 0) {
+            return;
+        }
+        sVectors[best].pending = false;
+        sInHandler = true;
+        sHandlerRuns++;
+        sVectors[best].handler();
+        sInHandler = false;
+    }
+}
+
+bool IntMasterEnable(void)
+{
+    const bool wasDisabled = !sMasterEnabled;
+    sMasterEnabled = true;
+    simDeliverInterrupts();
+    return wasDisabled;
+}
+
+bool IntMasterDisable(void)
+{
+    const bool wasDisabled = !sMasterEnabled;
+    sMasterEnabled = false;
+    return wasDisabled;
+}
+
+void IntRegister(uint32_t ui32Interrupt, void (*pfnHandler)(void))
+{
+    if (ui32Interrupt < NUM_INTERRUPTS) {
+        sVectors[ui32Interrupt].handler = pfnHandler;
+    }
+}
+
+void IntEnable(uint32_t ui32Interrupt)
+{
+    if (ui32Interrupt < NUM_INTERRUPTS) {
+        sVectors[ui32Interrupt].enabled = true;
+        simDeliverInterrupts();
+    }
+}
+
+void IntDisable(uint32_t ui32Interrupt)
+{
+    if (ui32Interrupt < NUM_INTERRUPTS) {
+        sVectors[ui32Interrupt].enabled = false;
+    }
+}
+
+void IntPrioritySet(uint32_t ui32Interrupt, uint8_t ui8Priority)
+{
+    if (ui32Interrupt < NUM_INTERRUPTS) {
+        sVectors[ui32Interrupt].priority = ui8Priority;
+    }
+}
+
+void IntPendSet(uint32_t ui32Interrupt)
+{
+    simRaise(ui32Interrupt);
+    simDeliverInterrupts();
+}
+
+// Wakes on the next interrupt: returns once a handler has run, or once one
+// is pending while the master enable is off.
+void CPUwfi(void)
+{
+    const uint64_t runs = sHandlerRuns;
+    while (!simAnyPending() && (sHandlerRuns == runs)) {
+        if (!simStep(UINT64_MAX)) {
+            return;   // nothing will ever happen
+        }
+    }
+}
+
+// ============================================================================
+// System control
+// ============================================================================
+// Any VCO division is accepted; anything else keeps the current clock and
+// fails like the driverlib call
+uint32_t SysCtlClockFreqSet(uint32_t, uint32_t ui32SysClock)
+{
+    if ((ui32SysClock == 0U) || ((SIM_TICK_HZ % ui32SysClock) != 0U)) {
+        return 0U;
+    }
+    sCycleBase = simCpuCycles();
+    sCycleBaseTick = sNow;
+    sClockHz = ui32SysClock;
+    sTicksPerCycle = SIM_TICK_HZ / ui32SysClock;
+    simTimersClockChanged();
+    return sClockHz;
+}
+
+void SysCtlPeripheralEnable(uint32_t) {}
+void SysCtlPeripheralDisable(uint32_t) {}
+bool SysCtlPeripheralReady(uint32_t) { return true; }
+void SysCtlPeripheralSleepEnable(uint32_t) {}
+void SysCtlPeripheralClockGating(bool) {}
+void SysCtlSleep(void) { CPUwfi(); }
+
+// Three cycles per loop, as on the target
+void SysCtlDelay(uint32_t ui32Count)
+{
+    simRunUntil(simTicksAfterCycles(3ULL * ui32Count));
+}
+
+void FPUEnable(void) {}
+void FPULazyStackingEnable(void) {}
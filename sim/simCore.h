@@ -0,0 +1,101 @@
+#ifndef SIM_CORE_H_
+#define SIM_CORE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Host simulation core
+//
+// A virtual clock, a small NVIC and an event queue standing in for the
+// TM4C1294 peripherals. Firmware code runs in zero virtual time; the clock
+// only moves in CPUwfi() or when the harness advances it, and every
+// peripheral event (timer expiry, DMA completion, scripted pin change)
+// happens at an exact tick. Runs are therefore fully deterministic, which
+// is what lets the benchmark compare plain counts against a baseline.
+//
+// Virtual time counts ticks of the 480 MHz PLL VCO. Every system clock the
+// firmware can select divides it, so a clock switch changes how many ticks
+// one CPU cycle takes and nothing else; timers keep counting cycles.
+//
+// Interrupts are delivered one at a time, highest priority first, whenever
+// the master enable is on and no handler is running: at IntMasterEnable(),
+// IntEnable(), and as the clock advances. Handlers do not nest.
+// ============================================================================
+
+// Work done by the firmware, as seen at the hardware boundary
+struct SimCounters {
+    uint64_t grCalls;         // GrLib drawing calls (GrRectFill, GrStringDraw, ...)
+    uint64_t grPixels;        // pixels those calls asked a display driver to write
+    uint64_t spiBytes;        // bytes clocked out to the LCD, commands included
+    uint64_t spiCommands;     // of which command bytes
+    uint64_t panelPixels;     // pixels written into the panel's RAM
+    uint64_t uartBytes;       // bytes sent on UART0
+    uint64_t eepromWords;     // EEPROM words programmed
+};
+
+extern SimCounters gSimCounters;
+
+// ===== Clock =====
+static constexpr uint32_t SIM_TICK_HZ = 480000000U;
+
+uint64_t simNow();                        // virtual ticks since start
+uint32_t simClockHz();                    // as set by SysCtlClockFreqSet
+uint64_t simCpuCycles();                  // system clock cycles since start
+uint64_t simMsToTicks(uint32_t ms);
+uint32_t simTicksToMs(uint64_t ticks);
+
+// Time 'cycles' system clock cycles from now, at the current clock
+uint64_t simTicksAfterCycles(uint64_t cycles);
+
+// Runs every event up to and including 'tick' and leaves the clock there
+void simRunUntil(uint64_t tick);
+
+// Advances to the next event (at most 'limit'); returns false if there was none
+bool simStep(uint64_t limit);
+
+// ===== Events =====
+typedef void (*SimEventFn)(uint32_t arg);
+
+// Schedules fn(arg) at 'tick'. Returns a handle for simCancel().
+uint32_t simSchedule(uint64_t tick, SimEventFn fn, uint32_t arg);
+void simCancel(uint32_t handle);
+
+// ===== Interrupts =====
+void simRaise(uint32_t vector);           // sets the vector pending
+void simDeliverInterrupts();              // runs pending handlers if allowed
+bool simAnyPending();                     // pending and enabled (wakes WFI)
+
+// ===== Pins =====
+// Drives an input pin (buttons are active low and idle high). Edges raise
+// the port interrupt when enabled for that pin.
+void simSetPin(uint32_t port, uint8_t pins, bool high);
+
+// Same, at a future tick
+void simSchedulePin(uint64_t tick, uint32_t port, uint8_t pins, bool high);
+
+// Schedules a press of 'holdMs' starting 'atMs' from now
+void simPressButton(uint32_t port, uint8_t pins, uint32_t atMs, uint32_t holdMs);
+
+// ===== Touch overlay =====
+// Schedules a touch at panel pixel x/y of 'holdMs' starting 'atMs' from
+// now; the firmware reads it through touchOverlayRead()
+void simTouch(int16_t x, int16_t y, uint32_t atMs, uint32_t holdMs);
+
+// ===== Peripherals (simPeripherals.cpp) =====
+// Called by SysCtlClockFreqSet: moves the timers' pending expiries to the
+// new cycle length
+void simTimersClockChanged();
+
+// Blocking writes to the LCD's SPI bus: the core waits out the bit time, so
+// virtual time passes (and interrupts run) as it would on the target
+void simSpiBlockingWrite(uint32_t bytes);
+
+// ===== LCD panel (simLcd.cpp) =====
+// Bytes arriving on the LCD's SPI bus while D/C selects data
+void simLcdSpiWrite(const uint8_t *bytes, uint32_t count);
+
+// Panel RAM in RGB565 as received over SPI (row-major, 128x128)
+const uint16_t *simPanelPixels();
+
+#endif // SIM_CORE_H_
@@ -0,0 +1,223 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+extern "C" {
+#include "grlib/grlib.h"
+}
+
+#include "simCore.h"
+
+// ============================================================================
+// Stand-in for g_sFontFixed6x8
+//
+// Same metrics as the real font (6x8 cells, 5x7 glyphs plus spacing), but
+// the shapes are a fixed pseudo-random pattern per character: every glyph is
+// distinct and deterministic, which is all the counts need. Space is blank.
+// ============================================================================
+static constexpr uint32_t FONT_FIRST = 0x20U;
+static constexpr uint32_t FONT_LAST  = 0x7EU;
+static constexpr uint32_t FONT_H     = 8U;
+
+static uint8_t sFontData[(FONT_LAST - FONT_FIRST + 1U) * FONT_H];
+
+static const uint8_t *fontData()
+{
+    static bool built = false;
+    if (!built) {
+        for (uint32_t c = FONT_FIRST + 1U; c <= FONT_LAST; c++) {
+            uint32_t h = c * 2654435761U;
+            for (uint32_t r = 1U; r < FONT_H; r++) {   // row 0 stays blank
+                h ^= h >> 13;
+                h *= 0x5bd1e995U;
+                sFontData[(c - FONT_FIRST) * FONT_H + r] = static_cast<uint8_t>((h >> 8) & 0xF8U);
+            }
+        }
+        built = true;
+    }
+    return sFontData;
+}
+
+const tFont g_sFontFixed6x8 = {
+    0, 6, FONT_H, 7, FONT_FIRST, FONT_LAST, sFontData
+};
+
+// ============================================================================
+// Helpers
+// ============================================================================
+static inline int32_t maxOf(int32_t a, int32_t b) { return (a > b) ? a : b; }
+static inline int32_t minOf(int32_t a, int32_t b) { return (a < b) ? a : b; }
+
+static void lineH(const tContext *c, int32_t x1, int32_t x2, int32_t y)
+{
+    if (x1 > x2) {
+        const int32_t t = x1; x1 = x2; x2 = t;
+    }
+    const tRectangle &clip = c->sClipRegion;
+    if ((y < clip.i16YMin) || (y > clip.i16YMax)) {
+        return;
+    }
+    x1 = maxOf(x1, clip.i16XMin);
+    x2 = minOf(x2, clip.i16XMax);
+    if (x1 > x2) {
+        return;
+    }
+    gSimCounters.grPixels += static_cast<uint64_t>(x2 - x1 + 1);
+    c->psDisplay->pfnLineDrawH(c->psDisplay->pvDisplayData, x1, x2, y, c->ui32Foreground);
+}
+
+static void lineV(const tContext *c, int32_t x, int32_t y1, int32_t y2)
+{
+    if (y1 > y2) {
+        const int32_t t = y1; y1 = y2; y2 = t;
+    }
+    const tRectangle &clip = c->sClipRegion;
+    if ((x < clip.i16XMin) || (x > clip.i16XMax)) {
+        return;
+    }
+    y1 = maxOf(y1, clip.i16YMin);
+    y2 = minOf(y2, clip.i16YMax);
+    if (y1 > y2) {
+        return;
+    }
+    gSimCounters.grPixels += static_cast<uint64_t>(y2 - y1 + 1);
+    c->psDisplay->pfnLineDrawV(c->psDisplay->pvDisplayData, x, y1, y2, c->ui32Foreground);
+}
+
+// ============================================================================
+// GrLib API
+// ============================================================================
+void GrContextInit(tContext *psContext, const tDisplay *psDisplay)
+{
+    psContext->i32Size = sizeof(tContext);
+    psContext->psDisplay = psDisplay;
+    psContext->sClipRegion.i16XMin = 0;
+    psContext->sClipRegion.i16YMin = 0;
+    psContext->sClipRegion.i16XMax = static_cast<int16_t>(psDisplay->ui16Width - 1);
+    psContext->sClipRegion.i16YMax = static_cast<int16_t>(psDisplay->ui16Height - 1);
+    psContext->ui32Foreground = 0;
+    psContext->ui32Background = 0;
+    psContext->psFont = nullptr;
+    fontData();
+}
+
+void GrPixelDraw(const tContext *psContext, int32_t i32X, int32_t i32Y)
+{
+    gSimCounters.grCalls++;
+    const tRectangle &clip = psContext->sClipRegion;
+    if ((i32X < clip.i16XMin) || (i32X > clip.i16XMax) ||
+        (i32Y < clip.i16YMin) || (i32Y > clip.i16YMax)) {
+        return;
+    }
+    gSimCounters.grPixels++;
+    psContext->psDisplay->pfnPixelDraw(psContext->psDisplay->pvDisplayData, i32X, i32Y,
+                                       psContext->ui32Foreground);
+}
+
+void GrLineDrawH(const tContext *psContext, int32_t i32X1, int32_t i32X2, int32_t i32Y)
+{
+    gSimCounters.grCalls++;
+    lineH(psContext, i32X1, i32X2, i32Y);
+}
+
+void GrLineDrawV(const tContext *psContext, int32_t i32X, int32_t i32Y1, int32_t i32Y2)
+{
+    gSimCounters.grCalls++;
+    lineV(psContext, i32X, i32Y1, i32Y2);
+}
+
+void GrRectDraw(const tContext *psContext, const tRectangle *psRect)
+{
+    gSimCounters.grCalls++;
+    lineH(psContext, psRect->i16XMin, psRect->i16XMax, psRect->i16YMin);
+    if (psRect->i16YMin == psRect->i16YMax) {
+        return;
+    }
+    lineH(psContext, psRect->i16XMin, psRect->i16XMax, psRect->i16YMax);
+    if ((psRect->i16YMax - psRect->i16YMin) < 2) {
+        return;
+    }
+    lineV(psContext, psRect->i16XMin, psRect->i16YMin + 1, psRect->i16YMax - 1);
+    if (psRect->i16XMin != psRect->i16XMax) {
+        lineV(psContext, psRect->i16XMax, psRect->i16YMin + 1, psRect->i16YMax - 1);
+    }
+}
+
+void GrRectFill(const tContext *psContext, const tRectangle *psRect)
+{
+    gSimCounters.grCalls++;
+    const tRectangle &clip = psContext->sClipRegion;
+    tRectangle r;
+    r.i16XMin = static_cast<int16_t>(maxOf(minOf(psRect->i16XMin, psRect->i16XMax), clip.i16XMin));
+    r.i16XMax = static_cast<int16_t>(minOf(maxOf(psRect->i16XMin, psRect->i16XMax), clip.i16XMax));
+    r.i16YMin = static_cast<int16_t>(maxOf(minOf(psRect->i16YMin, psRect->i16YMax), clip.i16YMin));
+    r.i16YMax = static_cast<int16_t>(minOf(maxOf(psRect->i16YMin, psRect->i16YMax), clip.i16YMax));
+    if ((r.i16XMin > r.i16XMax) || (r.i16YMin > r.i16YMax)) {
+        return;
+    }
+    gSimCounters.grPixels += static_cast<uint64_t>(r.i16XMax - r.i16XMin + 1) *
+                             static_cast<uint64_t>(r.i16YMax - r.i16YMin + 1);
+    psContext->psDisplay->pfnRectFill(psContext->psDisplay->pvDisplayData, &r,
+                                      psContext->ui32Foreground);
+}
+
+int32_t GrStringWidthGet(const tContext *psContext, const char *pcString, int32_t i32Length)
+{
+    const uint32_t n = (i32Length < 0) ? static_cast<uint32_t>(strlen(pcString))
+                                       : static_cast<uint32_t>(i32Length);
+    return static_cast<int32_t>(n * psContext->psFont->ui8MaxWidth);
+}
+
+// Glyph rows go out as 1 bpp runs (opaque) or foreground spans (transparent)
+void GrStringDraw(const tContext *psContext, const char *pcString, int32_t i32Length,
+                  int32_t i32X, int32_t i32Y, uint32_t bOpaque)
+{
+    gSimCounters.grCalls++;
+    const tFont &font = *psContext->psFont;
+    const tRectangle &clip = psContext->sClipRegion;
+    const tDisplay &display = *psContext->psDisplay;
+    const uint32_t palette[2] = {psContext->ui32Background, psContext->ui32Foreground};
+    const int32_t w = font.ui8MaxWidth;
+
+    for (int32_t i = 0; (i32Length < 0) ? (pcString[i] != '\0') : (i < i32Length); i++) {
+        const int32_t x = i32X + i * w;
+        const int32_t c0 = maxOf(0, clip.i16XMin - x);
+        const int32_t c1 = minOf(w - 1, clip.i16XMax - x);
+        if (c0 > c1) {
+            continue;
+        }
+
+        uint32_t code = static_cast<uint8_t>(pcString[i]);
+        if ((code < font.ui8First) || (code > font.ui8Last)) {
+            code = font.ui8First;
+        }
+        const uint8_t *glyph = &font.pui8Data[(code - font.ui8First) * font.ui8Height];
+
+        for (int32_t r = 0; r < font.ui8Height; r++) {
+            const int32_t y = i32Y + r;
+            if ((y < clip.i16YMin) || (y > clip.i16YMax)) {
+                continue;
+            }
+            const uint8_t bits = glyph[r];
+            if (bOpaque) {
+                gSimCounters.grPixels += static_cast<uint64_t>(c1 - c0 + 1);
+                display.pfnPixelDrawMultiple(display.pvDisplayData, x + c0, y, c0, c1 - c0 + 1, 1,
+                                             &bits, reinterpret_cast<const uint8_t *>(palette));
+                continue;
+            }
+            for (int32_t col = c0; col <= c1; col++) {
+                if (((bits >> (7 - col)) & 1U) == 0U) {
+                    continue;
+                }
+                int32_t end = col;
+                while ((end + 1 <= c1) && ((bits >> (7 - (end + 1))) & 1U)) {
+                    end++;
+                }
+                gSimCounters.grPixels += static_cast<uint64_t>(end - col + 1);
+                display.pfnLineDrawH(display.pvDisplayData, x + col, x + end, y,
+                                     psContext->ui32Foreground);
+                col = end;
+            }
+        }
+    }
+}
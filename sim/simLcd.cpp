@@ -0,0 +1,228 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+extern "C" {
+#include "Crystalfontz128x128_ST7735.h"
+#include "HAL_EK_TM4C1294XL_Crystalfontz128x128_ST7735.h"
+#include "grlib/grlib.h"
+}
+
+#include "simCore.h"
+
+// ============================================================================
+// ST7735 panel model
+//
+// Decodes the SPI byte stream the way the controller does: CASET/RASET set
+// the address window, RAMWR streams big-endian RGB565 pixels into it with
+// auto-increment. Both the HAL's blocking writes and DMA'd framebuffer
+// strips end up here, so the two drawing paths are measured the same way;
+// the blocking writes also take their time on the bus.
+// Panel coordinates are the logical 0..127 (the glass offset is ignored).
+// ============================================================================
+static constexpr uint32_t PANEL_W = 128U;
+static constexpr uint32_t PANEL_H = 128U;
+
+static uint16_t sPanel[PANEL_W * PANEL_H];
+
+static uint8_t sCommand = 0;
+static uint8_t sArgs[4];
+static uint32_t sArgCount = 0;
+static uint32_t sX0 = 0, sX1 = PANEL_W - 1U, sY0 = 0, sY1 = PANEL_H - 1U;
+static uint32_t sX = 0, sY = 0;
+static bool sHaveHighByte = false;
+static uint8_t sHighByte = 0;
+
+static void panelData(uint8_t byte)
+{
+    if ((sCommand == CM_CASET) || (sCommand == CM_RASET)) {
+        if (sArgCount < 4U) {
+            sArgs[sArgCount++] = byte;
+        }
+        if (sArgCount == 4U) {
+            const uint32_t a = (static_cast<uint32_t>(sArgs[0]) << 8) | sArgs[1];
+            const uint32_t b = (static_cast<uint32_t>(sArgs[2]) << 8) | sArgs[3];
+            if (sCommand == CM_CASET) {
+                sX0 = a;
+                sX1 = b;
+            } else {
+                sY0 = a;
+                sY1 = b;
+            }
+        }
+        return;
+    }
+    if (sCommand != CM_RAMWR) {
+        return;
+    }
+
+    if (!sHaveHighByte) {
+        sHighByte = byte;
+        sHaveHighByte = true;
+        return;
+    }
+    sHaveHighByte = false;
+    if ((sX < PANEL_W) && (sY < PANEL_H)) {
+        sPanel[sY * PANEL_W + sX] = static_cast<uint16_t>((sHighByte << 8) | byte);
+    }
+    gSimCounters.panelPixels++;
+
+    if (++sX > sX1) {
+        sX = sX0;
+        if (++sY > sY1) {
+            sY = sY0;
+        }
+    }
+}
+
+void HAL_LCD_PortInit(void) {}
+void HAL_LCD_SpiInit(void) {}
+
+void HAL_LCD_writeCommand(uint8_t command)
+{
+    gSimCounters.spiBytes++;
+    gSimCounters.spiCommands++;
+    simSpiBlockingWrite(1U);
+    sCommand = command;
+    sArgCount = 0U;
+    sHaveHighByte = false;
+    if (command == CM_RAMWR) {
+        sX = sX0;
+        sY = sY0;
+    }
+}
+
+void HAL_LCD_writeData(uint8_t data)
+{
+    gSimCounters.spiBytes++;
+    simSpiBlockingWrite(1U);
+    panelData(data);
+}
+
+void simLcdSpiWrite(const uint8_t *bytes, uint32_t count)
+{
+    gSimCounters.spiBytes += count;
+    for (uint32_t i = 0; i < count; i++) {
+        panelData(bytes[i]);
+    }
+}
+
+const uint16_t *simPanelPixels()
+{
+    return sPanel;
+}
+
+// ============================================================================
+// Crystalfontz128x128 GrLib driver, with the reference driver's SPI pattern:
+// every primitive sets a window and streams its pixels.
+// ============================================================================
+void Crystalfontz128x128_Init(void)
+{
+    memset(sPanel, 0, sizeof(sPanel));
+}
+
+void Crystalfontz128x128_SetOrientation(uint8_t) {}
+
+void Crystalfontz128x128_SetDrawFrame(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+    HAL_LCD_writeCommand(CM_CASET);
+    HAL_LCD_writeData(static_cast<uint8_t>(x0 >> 8));
+    HAL_LCD_writeData(static_cast<uint8_t>(x0));
+    HAL_LCD_writeData(static_cast<uint8_t>(x1 >> 8));
+    HAL_LCD_writeData(static_cast<uint8_t>(x1));
+    HAL_LCD_writeCommand(CM_RASET);
+    HAL_LCD_writeData(static_cast<uint8_t>(y0 >> 8));
+    HAL_LCD_writeData(static_cast<uint8_t>(y0));
+    HAL_LCD_writeData(static_cast<uint8_t>(y1 >> 8));
+    HAL_LCD_writeData(static_cast<uint8_t>(y1));
+}
+
+static void writePixels(uint32_t value, uint32_t count)
+{
+    HAL_LCD_writeCommand(CM_RAMWR);
+    for (uint32_t i = 0; i < count; i++) {
+        HAL_LCD_writeData(static_cast<uint8_t>(value >> 8));
+        HAL_LCD_writeData(static_cast<uint8_t>(value));
+    }
+}
+
+static void cfPixelDraw(void *, int32_t x, int32_t y, uint32_t value)
+{
+    Crystalfontz128x128_SetDrawFrame(static_cast<uint16_t>(x), static_cast<uint16_t>(y),
+                                     static_cast<uint16_t>(x), static_cast<uint16_t>(y));
+    writePixels(value, 1U);
+}
+
+static void cfPixelDrawMultiple(void *, int32_t x, int32_t y, int32_t x0, int32_t count,
+                                int32_t bpp, const uint8_t *data, const uint8_t *palette)
+{
+    if (((bpp & 0xFF) != 1) || (count <= 0)) {
+        return;   // the firmware only draws 1 bpp glyphs
+    }
+    Crystalfontz128x128_SetDrawFrame(static_cast<uint16_t>(x), static_cast<uint16_t>(y),
+                                     static_cast<uint16_t>(x + count - 1),
+                                     static_cast<uint16_t>(y));
+    HAL_LCD_writeCommand(CM_RAMWR);
+    const uint32_t *colors = reinterpret_cast<const uint32_t *>(palette);
+    while (count > 0) {
+        const uint32_t byte = *data++;
+        for (; (x0 < 8) && (count > 0); x0++, count--) {
+            const uint32_t value = colors[(byte >> (7 - x0)) & 1U];
+            HAL_LCD_writeData(static_cast<uint8_t>(value >> 8));
+            HAL_LCD_writeData(static_cast<uint8_t>(value));
+        }
+        x0 = 0;
+    }
+}
+
+static void cfLineDrawH(void *, int32_t x1, int32_t x2, int32_t y, uint32_t value)
+{
+    if (x1 > x2) {
+        const int32_t t = x1; x1 = x2; x2 = t;
+    }
+    Crystalfontz128x128_SetDrawFrame(static_cast<uint16_t>(x1), static_cast<uint16_t>(y),
+                                     static_cast<uint16_t>(x2), static_cast<uint16_t>(y));
+    writePixels(value, static_cast<uint32_t>(x2 - x1 + 1));
+}
+
+static void cfLineDrawV(void *, int32_t x, int32_t y1, int32_t y2, uint32_t value)
+{
+    if (y1 > y2) {
+        const int32_t t = y1; y1 = y2; y2 = t;
+    }
+    Crystalfontz128x128_SetDrawFrame(static_cast<uint16_t>(x), static_cast<uint16_t>(y1),
+                                     static_cast<uint16_t>(x), static_cast<uint16_t>(y2));
+    writePixels(value, static_cast<uint32_t>(y2 - y1 + 1));
+}
+
+static void cfRectFill(void *, const tRectangle *rect, uint32_t value)
+{
+    Crystalfontz128x128_SetDrawFrame(static_cast<uint16_t>(rect->i16XMin),
+                                     static_cast<uint16_t>(rect->i16YMin),
+                                     static_cast<uint16_t>(rect->i16XMax),
+                                     static_cast<uint16_t>(rect->i16YMax));
+    writePixels(value, static_cast<uint32_t>((rect->i16XMax - rect->i16XMin + 1) *
+                                             (rect->i16YMax - rect->i16YMin + 1)));
+}
+
+static uint32_t cfColorTranslate(void *, uint32_t value)
+{
+    return ((value & 0x00F80000U) >> 8) | ((value & 0x0000FC00U) >> 5) |
+           ((value & 0x000000F8U) >> 3);
+}
+
+static void cfFlush(void *) {}
+
+const tDisplay g_sCrystalfontz128x128 = {
+    sizeof(tDisplay),
+    nullptr,
+    PANEL_W,
+    PANEL_H,
+    cfPixelDraw,
+    cfPixelDrawMultiple,
+    cfLineDrawH,
+    cfLineDrawV,
+    cfRectFill,
+    cfColorTranslate,
+    cfFlush
+};
@@ -0,0 +1,86 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "driverlib/gpio.h"
+#include "inc/hw_memmap.h"
+}
+
+#include "button.h"
+#include "timerLib.h"
+#include "simCore.h"
+
+// ============================================================================
+// timerLib
+// ============================================================================
+void Timer::begin(uint32_t, uint32_t) {}
+
+uint32_t Timer::millis() const
+{
+    return simTicksToMs(simNow());
+}
+
+// ============================================================================
+// Button: S1 = PH1, S2 = PK6, active low. A level must hold for the
+// debounce time (counted in ticks) before it is reported.
+// ============================================================================
+Button::Button(ButtonPin pin)
+    : m_port((pin == S1) ? GPIO_PORTH_BASE : GPIO_PORTK_BASE),
+      m_pin((pin == S1) ? GPIO_PIN_1 : GPIO_PIN_6),
+      m_tickMs(10U), m_debounceMs(30U), m_stableMs(0U),
+      m_pressed(false), m_pressEvent(false), m_releaseEvent(false)
+{
+}
+
+void Button::begin()
+{
+    m_pressed = readPressed();
+}
+
+void Button::setTickIntervalMs(uint32_t ms)
+{
+    m_tickMs = ms;
+}
+
+void Button::setDebounceMs(uint32_t ms)
+{
+    m_debounceMs = ms;
+}
+
+bool Button::readPressed() const
+{
+    return GPIOPinRead(m_port, m_pin) == 0;
+}
+
+void Button::tick()
+{
+    if (readPressed() == m_pressed) {
+        m_stableMs = 0U;
+        return;
+    }
+    m_stableMs += m_tickMs;
+    if (m_stableMs < m_debounceMs) {
+        return;
+    }
+    m_stableMs = 0U;
+    m_pressed = !m_pressed;
+    if (m_pressed) {
+        m_pressEvent = true;
+    } else {
+        m_releaseEvent = true;
+    }
+}
+
+bool Button::wasPressed()
+{
+    const bool event = m_pressEvent;
+    m_pressEvent = false;
+    return event;
+}
+
+bool Button::wasReleased()
+{
+    const bool event = m_releaseEvent;
+    m_releaseEvent = false;
+    return event;
+}
@@ -0,0 +1,668 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+extern "C" {
+#include "driverlib/eeprom.h"
+#include "driverlib/gpio.h"
+#include "driverlib/hibernate.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/ssi.h"
+#include "driverlib/timer.h"
+#include "driverlib/uart.h"
+#include "driverlib/udma.h"
+#include "driverlib/watchdog.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_ssi.h"
+#include "inc/hw_uart.h"
+}
+
+#include "simCore.h"
+#include "inputSource.h"
+#include "resumeSnapshot.h"
+
+// LCD SPI bit rate used for DMA completion timing; the HAL sets up 15 MHz
+static uint32_t sSsiBitRate = 15000000U;
+
+// ============================================================================
+// General-purpose timers
+// ============================================================================
+struct SimTimer {
+    uint32_t base;
+    uint32_t vector;
+    uint32_t config;
+    uint32_t load;
+    uint32_t intMask;
+    uint32_t raw;
+    bool enabled;
+    uint64_t start;       // CPU cycle the current period began
+    uint32_t event;       // pending expiry handle
+    bool hasMatch;        // TimerMatchSet() was called (up-counting only)
+    uint32_t match;
+    uint32_t matchEvent;  // pending match handle
+};
+
+static SimTimer sTimers[] = {
+    {TIMER0_BASE, INT_TIMER0A, 0, 0xFFFFFFFFU, 0, 0, false, 0, 0, false, 0, 0},
+    {TIMER1_BASE, INT_TIMER1A, 0, 0xFFFFFFFFU, 0, 0, false, 0, 0, false, 0, 0},
+    {TIMER2_BASE, INT_TIMER2A, 0, 0xFFFFFFFFU, 0, 0, false, 0, 0, false, 0, 0},
+    {TIMER3_BASE, INT_TIMER3A, 0, 0xFFFFFFFFU, 0, 0, false, 0, 0, false, 0, 0},
+};
+static constexpr uint32_t TIMER_COUNT = sizeof(sTimers) / sizeof(sTimers[0]);
+
+static SimTimer *timerOf(uint32_t base)
+{
+    for (uint32_t i = 0; i < TIMER_COUNT; i++) {
+        if (sTimers[i].base == base) {
+            return &sTimers[i];
+        }
+    }
+    return nullptr;
+}
+
+static inline uint64_t timerPeriod(const SimTimer &t)
+{
+    return static_cast<uint64_t>(t.load) + 1U;
+}
+
+static void matchReached(uint32_t index);
+
+// Schedules the next time an up-counting timer's count equals its match
+// value; a match the count is on or past comes round in the next period
+static void scheduleMatch(SimTimer &t)
+{
+    simCancel(t.matchEvent);
+    t.matchEvent = 0U;
+    if (!t.enabled || !t.hasMatch || ((t.config & 0x10U) == 0U)) {
+        return;
+    }
+    const uint64_t period = timerPeriod(t);
+    const uint64_t count = (simCpuCycles() - t.start) % period;
+    const uint64_t wait = (t.match > count) ? (t.match - count) : (period - count + t.match);
+    t.matchEvent = simSchedule(simTicksAfterCycles(wait), matchReached,
+                               static_cast<uint32_t>(&t - sTimers));
+}
+
+static void matchReached(uint32_t index)
+{
+    SimTimer &t = sTimers[index];
+    t.matchEvent = 0U;
+    t.raw |= TIMER_TIMA_MATCH;
+    if (t.intMask & TIMER_TIMA_MATCH) {
+        simRaise(t.vector);
+    }
+    scheduleMatch(t);
+}
+
+static void timerExpired(uint32_t index)
+{
+    SimTimer &t = sTimers[index];
+    t.event = 0U;
+    t.raw |= TIMER_TIMA_TIMEOUT;
+    if (t.intMask & TIMER_TIMA_TIMEOUT) {
+        simRaise(t.vector);
+    }
+
+    const bool oneShot = (t.config & 0x0FU) == 0x01U;
+    if (oneShot) {
+        t.enabled = false;
+        return;
+    }
+    t.start = simCpuCycles();
+    t.event = simSchedule(simTicksAfterCycles(timerPeriod(t)), timerExpired, index);
+}
+
+void TimerConfigure(uint32_t ui32Base, uint32_t ui32Config)
+{
+    SimTimer *t = timerOf(ui32Base);
+    if (t != nullptr) {
+        t->config = ui32Config;
+    }
+}
+
+// A running timer starts a new period with the new load
+void TimerLoadSet(uint32_t ui32Base, uint32_t, uint32_t ui32Value)
+{
+    SimTimer *t = timerOf(ui32Base);
+    if (t == nullptr) {
+        return;
+    }
+    t->load = ui32Value;
+    if (t->enabled) {
+        simCancel(t->event);
+        t->start = simCpuCycles();
+        t->event = simSchedule(simTicksAfterCycles(timerPeriod(*t)), timerExpired,
+                               static_cast<uint32_t>(t - sTimers));
+        scheduleMatch(*t);
+    }
+}
+
+uint32_t TimerLoadGet(uint32_t ui32Base, uint32_t)
+{
+    SimTimer *t = timerOf(ui32Base);
+    return (t != nullptr) ? t->load : 0U;
+}
+
+void TimerMatchSet(uint32_t ui32Base, uint32_t, uint32_t ui32Value)
+{
+    SimTimer *t = timerOf(ui32Base);
+    if (t != nullptr) {
+        t->hasMatch = true;
+        t->match = ui32Value;
+        scheduleMatch(*t);
+    }
+}
+
+void TimerEnable(uint32_t ui32Base, uint32_t)
+{
+    SimTimer *t = timerOf(ui32Base);
+    if ((t == nullptr) || t->enabled) {
+        return;
+    }
+    t->enabled = true;
+    t->start = simCpuCycles();
+    t->event = simSchedule(simTicksAfterCycles(timerPeriod(*t)), timerExpired,
+                           static_cast<uint32_t>(t - sTimers));
+    scheduleMatch(*t);
+}
+
+void TimerDisable(uint32_t ui32Base, uint32_t)
+{
+    SimTimer *t = timerOf(ui32Base);
+    if ((t == nullptr) || !t->enabled) {
+        return;
+    }
+    t->enabled = false;
+    simCancel(t->event);
+    t->event = 0U;
+    scheduleMatch(*t);
+}
+
+uint32_t TimerValueGet(uint32_t ui32Base, uint32_t)
+{
+    SimTimer *t = timerOf(ui32Base);
+    if ((t == nullptr) || !t->enabled) {
+        return 0U;
+    }
+    const uint64_t elapsed = (simCpuCycles() - t->start) % timerPeriod(*t);
+    const bool up = (t->config & 0x10U) != 0U;
+    return up ? static_cast<uint32_t>(elapsed) : static_cast<uint32_t>(t->load - elapsed);
+}
+
+void simTimersClockChanged()
+{
+    for (uint32_t i = 0; i < TIMER_COUNT; i++) {
+        SimTimer &t = sTimers[i];
+        if (!t.enabled) {
+            continue;
+        }
+        const uint64_t elapsed = (simCpuCycles() - t.start) % timerPeriod(t);
+        simCancel(t.event);
+        t.event = simSchedule(simTicksAfterCycles(timerPeriod(t) - elapsed), timerExpired, i);
+        scheduleMatch(t);
+    }
+}
+
+void TimerIntRegister(uint32_t ui32Base, uint32_t, void (*pfnHandler)(void))
+{
+    SimTimer *t = timerOf(ui32Base);
+    if (t != nullptr) {
+        IntRegister(t->vector, pfnHandler);
+        IntEnable(t->vector);
+    }
+}
+
+void TimerIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    SimTimer *t = timerOf(ui32Base);
+    if (t != nullptr) {
+        t->intMask |= ui32IntFlags;
+    }
+}
+
+void TimerIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    SimTimer *t = timerOf(ui32Base);
+    if (t != nullptr) {
+        t->intMask &= ~ui32IntFlags;
+    }
+}
+
+void TimerIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    SimTimer *t = timerOf(ui32Base);
+    if (t != nullptr) {
+        t->raw &= ~ui32IntFlags;
+    }
+}
+
+uint32_t TimerIntStatus(uint32_t ui32Base, bool bMasked)
+{
+    SimTimer *t = timerOf(ui32Base);
+    if (t == nullptr) {
+        return 0U;
+    }
+    return bMasked ? (t->raw & t->intMask) : t->raw;
+}
+
+// ============================================================================
+// GPIO
+// ============================================================================
+struct SimPort {
+    uint32_t base;
+    uint32_t vector;
+    uint8_t level;        // inputs idle high (pull-ups)
+    uint8_t bothEdges;
+    uint8_t risingEdge;   // when not both: 1 = rising, 0 = falling
+    uint8_t intEnabled;
+    uint8_t raw;
+};
+
+static SimPort sPorts[] = {
+    {GPIO_PORTA_BASE, INT_GPIOA, 0xFF, 0, 0, 0, 0},
+    {GPIO_PORTD_BASE, INT_GPIOD, 0xFF, 0, 0, 0, 0},
+    {GPIO_PORTH_BASE, INT_GPIOH, 0xFF, 0, 0, 0, 0},
+    {GPIO_PORTJ_BASE, INT_GPIOJ, 0xFF, 0, 0, 0, 0},
+    {GPIO_PORTK_BASE, INT_GPIOK, 0xFF, 0, 0, 0, 0},
+    {GPIO_PORTL_BASE, INT_GPIOL, 0xFF, 0, 0, 0, 0},
+    {GPIO_PORTM_BASE, INT_GPIOM, 0xFF, 0, 0, 0, 0},
+};
+static constexpr uint32_t PORT_COUNT = sizeof(sPorts) / sizeof(sPorts[0]);
+
+static SimPort *portOf(uint32_t base)
+{
+    for (uint32_t i = 0; i < PORT_COUNT; i++) {
+        if (sPorts[i].base == base) {
+            return &sPorts[i];
+        }
+    }
+    return nullptr;
+}
+
+void simSetPin(uint32_t port, uint8_t pins, bool high)
+{
+    SimPort *p = portOf(port);
+    if (p == nullptr) {
+        return;
+    }
+    const uint8_t before = p->level;
+    p->level = high ? static_cast<uint8_t>(before | pins) : static_cast<uint8_t>(before & ~pins);
+
+    const uint8_t rose = static_cast<uint8_t>(p->level & ~before);
+    const uint8_t fell = static_cast<uint8_t>(before & ~p->level);
+    const uint8_t hits = static_cast<uint8_t>(
+        (p->bothEdges & (rose | fell)) |
+        (~p->bothEdges & p->risingEdge & rose) |
+        (~p->bothEdges & ~p->risingEdge & fell));
+    p->raw |= hits;
+    if (hits & p->intEnabled) {
+        simRaise(p->vector);
+    }
+}
+
+// arg: port index << 16 | pins << 8 | level
+static void pinEvent(uint32_t arg)
+{
+    simSetPin(sPorts[arg >> 16].base, static_cast<uint8_t>(arg >> 8), (arg & 1U) != 0U);
+}
+
+void simSchedulePin(uint64_t tick, uint32_t port, uint8_t pins, bool high)
+{
+    SimPort *p = portOf(port);
+    if (p != nullptr) {
+        const uint32_t index = static_cast<uint32_t>(p - sPorts);
+        simSchedule(tick, pinEvent, (index << 16) | (static_cast<uint32_t>(pins) << 8) |
+                                         (high ? 1U : 0U));
+    }
+}
+
+void simPressButton(uint32_t port, uint8_t pins, uint32_t atMs, uint32_t holdMs)
+{
+    const uint64_t down = simNow() + simMsToTicks(atMs);
+    simSchedulePin(down, port, pins, false);
+    simSchedulePin(down + simMsToTicks(holdMs), port, pins, true);
+}
+
+void GPIOPinTypeGPIOInput(uint32_t, uint8_t) {}
+void GPIOPinTypeGPIOOutput(uint32_t, uint8_t) {}
+void GPIOPinTypeUART(uint32_t, uint8_t) {}
+void GPIOPadConfigSet(uint32_t, uint8_t, uint32_t, uint32_t) {}
+void GPIOPinConfigure(uint32_t) {}
+
+int32_t GPIOPinRead(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    SimPort *p = portOf(ui32Port);
+    return (p != nullptr) ? (p->level & ui8Pins) : 0;
+}
+
+void GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val)
+{
+    SimPort *p = portOf(ui32Port);
+    if (p != nullptr) {
+        p->level = static_cast<uint8_t>((p->level & ~ui8Pins) | (ui8Val & ui8Pins));
+    }
+}
+
+void GPIOIntTypeSet(uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32IntType)
+{
+    SimPort *p = portOf(ui32Port);
+    if (p == nullptr) {
+        return;
+    }
+    p->bothEdges = static_cast<uint8_t>(p->bothEdges & ~ui8Pins);
+    p->risingEdge = static_cast<uint8_t>(p->risingEdge & ~ui8Pins);
+    if (ui32IntType == GPIO_BOTH_EDGES) {
+        p->bothEdges |= ui8Pins;
+    } else if (ui32IntType == GPIO_RISING_EDGE) {
+        p->risingEdge |= ui8Pins;
+    }
+}
+
+void GPIOIntEnable(uint32_t ui32Port, uint32_t ui32IntFlags)
+{
+    SimPort *p = portOf(ui32Port);
+    if (p != nullptr) {
+        p->intEnabled |= static_cast<uint8_t>(ui32IntFlags);
+    }
+}
+
+void GPIOIntDisable(uint32_t ui32Port, uint32_t ui32IntFlags)
+{
+    SimPort *p = portOf(ui32Port);
+    if (p != nullptr) {
+        p->intEnabled &= static_cast<uint8_t>(~ui32IntFlags);
+    }
+}
+
+void GPIOIntClear(uint32_t ui32Port, uint32_t ui32IntFlags)
+{
+    SimPort *p = portOf(ui32Port);
+    if (p != nullptr) {
+        p->raw &= static_cast<uint8_t>(~ui32IntFlags);
+    }
+}
+
+uint32_t GPIOIntStatus(uint32_t ui32Port, bool bMasked)
+{
+    SimPort *p = portOf(ui32Port);
+    if (p == nullptr) {
+        return 0U;
+    }
+    return bMasked ? (p->raw & p->intEnabled) : p->raw;
+}
+
+void GPIOIntRegister(uint32_t ui32Port, void (*pfnIntHandler)(void))
+{
+    SimPort *p = portOf(ui32Port);
+    if (p != nullptr) {
+        IntRegister(p->vector, pfnIntHandler);
+        IntEnable(p->vector);
+    }
+}
+
+// ============================================================================
+// Touch overlay: one touch at a time, read back exactly
+// ============================================================================
+static TouchPoint sTouchPoint = {0, 0};
+static bool sTouched = false;
+
+// arg: x << 16 | y, or NO_TOUCH
+static constexpr uint32_t NO_TOUCH = 0xFFFFFFFFU;
+
+static void touchEvent(uint32_t arg)
+{
+    sTouched = (arg != NO_TOUCH);
+    if (sTouched) {
+        sTouchPoint = {static_cast<int16_t>(arg >> 16), static_cast<int16_t>(arg & 0xFFFFU)};
+    }
+}
+
+void simTouch(int16_t x, int16_t y, uint32_t atMs, uint32_t holdMs)
+{
+    const uint64_t down = simNow() + simMsToTicks(atMs);
+    simSchedule(down, touchEvent, (static_cast<uint32_t>(static_cast<uint16_t>(x)) << 16) |
+                                      static_cast<uint16_t>(y));
+    simSchedule(down + simMsToTicks(holdMs), touchEvent, NO_TOUCH);
+}
+
+bool touchOverlayRead(TouchPoint &point)
+{
+    point = sTouchPoint;
+    return sTouched;
+}
+
+// ============================================================================
+// SSI (LCD) and UART0: only the DMA-done interrupt is modelled
+// ============================================================================
+static bool sSsiDmaIntEnabled = false;
+static bool sUartDmaIntEnabled = false;
+static uint32_t sUartBaud = 115200U;
+
+void SSIIntRegister(uint32_t, void (*pfnHandler)(void))
+{
+    IntRegister(INT_SSI2, pfnHandler);
+    IntEnable(INT_SSI2);
+}
+
+void SSIIntEnable(uint32_t, uint32_t ui32IntFlags)
+{
+    sSsiDmaIntEnabled |= (ui32IntFlags & SSI_DMATX) != 0U;
+}
+
+void SSIIntClear(uint32_t, uint32_t) {}
+void SSIDMAEnable(uint32_t, uint32_t) {}
+bool SSIBusy(uint32_t) { return false; }
+void SSIEnable(uint32_t) {}
+void SSIDisable(uint32_t) {}
+
+void SSIConfigSetExpClk(uint32_t, uint32_t, uint32_t, uint32_t, uint32_t ui32BitRate, uint32_t)
+{
+    sSsiBitRate = ui32BitRate;
+}
+
+void simSpiBlockingWrite(uint32_t bytes)
+{
+    simRunUntil(simNow() + static_cast<uint64_t>(bytes) * 8U * SIM_TICK_HZ / sSsiBitRate);
+}
+
+void UARTConfigSetExpClk(uint32_t, uint32_t, uint32_t ui32Baud, uint32_t)
+{
+    sUartBaud = ui32Baud;
+}
+
+void UARTFIFOEnable(uint32_t) {}
+void UARTDMAEnable(uint32_t, uint32_t) {}
+
+void UARTIntRegister(uint32_t, void (*pfnHandler)(void))
+{
+    IntRegister(INT_UART0, pfnHandler);
+    IntEnable(INT_UART0);
+}
+
+void UARTIntEnable(uint32_t, uint32_t ui32IntFlags)
+{
+    sUartDmaIntEnabled |= (ui32IntFlags & UART_INT_DMATX) != 0U;
+}
+
+void UARTIntClear(uint32_t, uint32_t) {}
+
+void UARTCharPut(uint32_t, unsigned char)
+{
+    gSimCounters.uartBytes++;
+}
+
+bool UARTCharsAvail(uint32_t) { return false; }
+int32_t UARTCharGetNonBlocking(uint32_t) { return -1; }
+bool UARTBusy(uint32_t) { return false; }
+
+// ============================================================================
+// uDMA: a transfer hands its bytes to the sink at once and completes after
+// the time the serial link would need for them
+// ============================================================================
+static constexpr uint32_t DMA_CHANNELS = 32U;
+
+struct SimDmaChannel {
+    const uint8_t *src;
+    uintptr_t dst;
+    uint32_t count;
+    bool enabled;
+};
+static SimDmaChannel sDma[DMA_CHANNELS] = {};
+
+static void dmaDone(uint32_t ch)
+{
+    SimDmaChannel &c = sDma[ch];
+    c.enabled = false;
+    if ((c.dst == SSI2_BASE + SSI_O_DR) && sSsiDmaIntEnabled) {
+        simRaise(INT_SSI2);
+    } else if ((c.dst == UART0_BASE + UART_O_DR) && sUartDmaIntEnabled) {
+        simRaise(INT_UART0);
+    }
+}
+
+void uDMAEnable(void) {}
+void uDMAControlBaseSet(void *) {}
+void uDMAChannelAssign(uint32_t) {}
+void uDMAChannelAttributeEnable(uint32_t, uint32_t) {}
+void uDMAChannelAttributeDisable(uint32_t, uint32_t) {}
+void uDMAChannelControlSet(uint32_t, uint32_t) {}
+
+void uDMAChannelTransferSet(uint32_t ui32ChannelStructIndex, uint32_t, void *pvSrcAddr,
+                            void *pvDstAddr, uint32_t ui32TransferSize)
+{
+    SimDmaChannel &c = sDma[ui32ChannelStructIndex & (DMA_CHANNELS - 1U)];
+    c.src = static_cast<const uint8_t *>(pvSrcAddr);
+    c.dst = reinterpret_cast<uintptr_t>(pvDstAddr);
+    c.count = ui32TransferSize;
+}
+
+void uDMAChannelEnable(uint32_t ui32ChannelNum)
+{
+    const uint32_t ch = ui32ChannelNum & (DMA_CHANNELS - 1U);
+    SimDmaChannel &c = sDma[ch];
+    c.enabled = true;
+
+    uint64_t ticks = 0U;
+    if (c.dst == SSI2_BASE + SSI_O_DR) {
+        simLcdSpiWrite(c.src, c.count);
+        ticks = static_cast<uint64_t>(c.count) * 8U * SIM_TICK_HZ / sSsiBitRate;
+    } else if (c.dst == UART0_BASE + UART_O_DR) {
+        gSimCounters.uartBytes += c.count;
+        ticks = static_cast<uint64_t>(c.count) * 10U * SIM_TICK_HZ / sUartBaud;
+    }
+    simSchedule(simTicksAfterCycles(1U) + ticks, dmaDone, ch);
+}
+
+bool uDMAChannelIsEnabled(uint32_t ui32ChannelNum)
+{
+    return sDma[ui32ChannelNum & (DMA_CHANNELS - 1U)].enabled;
+}
+
+// ============================================================================
+// EEPROM (6 KB, erased to all ones, programs instantly)
+// ============================================================================
+static constexpr uint32_t EEPROM_BYTES = 6144U;
+static uint32_t sEeprom[EEPROM_BYTES / 4U];
+static bool sEepromReady = false;
+
+uint32_t EEPROMInit(void)
+{
+    if (!sEepromReady) {
+        memset(sEeprom, 0xFF, sizeof(sEeprom));
+        sEepromReady = true;
+    }
+    return EEPROM_INIT_OK;
+}
+
+uint32_t EEPROMSizeGet(void)
+{
+    return EEPROM_BYTES;
+}
+
+void EEPROMRead(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count)
+{
+    memcpy(pui32Data, &sEeprom[ui32Address / 4U], ui32Count);
+}
+
+uint32_t EEPROMProgramNonBlocking(uint32_t ui32Data, uint32_t ui32Address)
+{
+    sEeprom[ui32Address / 4U] = ui32Data;
+    gSimCounters.eepromWords++;
+    return 0U;
+}
+
+uint32_t EEPROMStatusGet(void)
+{
+    return 0U;
+}
+
+// ============================================================================
+// Hibernation module: 16 battery-backed words and the RTC. Every run starts
+// from a cold module (no VBAT), so the firmware finds no snapshot. A data
+// write takes three 32.768 kHz cycles, as on the part.
+// ============================================================================
+static constexpr uint32_t HIB_WORDS = 16U;
+static constexpr uint32_t RTC_HZ = 32768U;
+static uint32_t sHibData[HIB_WORDS];
+static bool sHibActive = false;
+static bool sRtcEnabled = false;
+static uint64_t sRtcStartTicks = 0;
+static uint64_t sHibBusyUntil = 0;
+
+void HibernateEnableExpClk(uint32_t)
+{
+    sHibActive = true;
+}
+
+void HibernateClockConfig(uint32_t) {}
+
+bool HibernateIsActive(void)
+{
+    return sHibActive;
+}
+
+// Counts from 0 once first enabled; enabling it again changes nothing
+void HibernateRTCEnable(void)
+{
+    if (!sRtcEnabled) {
+        sRtcEnabled = true;
+        sRtcStartTicks = simNow();
+    }
+}
+
+uint32_t HibernateRTCGet(void)
+{
+    return static_cast<uint32_t>((simNow() - sRtcStartTicks) / SIM_TICK_HZ);
+}
+
+uint32_t HibernateRTCSSGet(void)
+{
+    const uint64_t within = (simNow() - sRtcStartTicks) % SIM_TICK_HZ;
+    return static_cast<uint32_t>(within * RTC_HZ / SIM_TICK_HZ);
+}
+
+void HibernateDataGet(uint32_t *pui32Data, uint32_t ui32Count)
+{
+    memcpy(pui32Data, sHibData, ui32Count * sizeof(uint32_t));
+}
+
+bool simHibernateWriteReady()
+{
+    return simNow() >= sHibBusyUntil;
+}
+
+void simHibernateWrite(uint32_t index, uint32_t value)
+{
+    sHibData[index % HIB_WORDS] = value;
+    sHibBusyUntil = simNow() + (3U * SIM_TICK_HZ + RTC_HZ - 1U) / RTC_HZ;
+}
+
+// ============================================================================
+// Watchdog (never bites: the harness drives the main loop at its own pace)
+// ============================================================================
+void WatchdogReloadSet(uint32_t, uint32_t) {}
+void WatchdogResetEnable(uint32_t) {}
+void WatchdogStallEnable(uint32_t) {}
+void WatchdogEnable(uint32_t) {}
+void WatchdogIntClear(uint32_t) {}
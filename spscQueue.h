@@ -0,0 +1,73 @@
+#ifndef SPSC_QUEUE_H_
+#define SPSC_QUEUE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <atomic>
+
+// ============================================================================
+// Single-producer / single-consumer lock-free ring buffer
+//
+// Meant for handing data from one ISR to the main loop (or the other way
+// around) on a single core: the producer only writes m_head, the consumer
+// only writes m_tail, and signal fences keep the compiler from moving the
+// slot access across the index update. CAPACITY must be a power of two; the
+// indices run freely and wrap, so all CAPACITY slots are usable.
+// ============================================================================
+template <typename T, uint32_t CAPACITY>
+class SpscQueue {
+    static_assert((CAPACITY != 0U) && ((CAPACITY & (CAPACITY - 1U)) == 0U),
+                  "SpscQueue capacity must be a power of two");
+
+public:
+    // Producer side. Returns false (and drops the item) when full.
+    bool push(const T &item)
+    {
+        const uint32_t head = m_head;
+        if ((head - m_tail) >= CAPACITY) {
+            return false;
+        }
+        m_items[head & MASK] = item;
+        std::atomic_signal_fence(std::memory_order_release);
+        m_head = head + 1U;
+        return true;
+    }
+
+    // Consumer side. Returns false when empty.
+    bool pop(T &item)
+    {
+        const uint32_t tail = m_tail;
+        if (tail == m_head) {
+            return false;
+        }
+        std::atomic_signal_fence(std::memory_order_acquire);
+        item = m_items[tail & MASK];
+        std::atomic_signal_fence(std::memory_order_release);
+        m_tail = tail + 1U;
+        return true;
+    }
+
+    // Consumer side: oldest item without removing it, or nullptr if empty.
+    const T *peek() const
+    {
+        const uint32_t tail = m_tail;
+        if (tail == m_head) {
+            return nullptr;
+        }
+        std::atomic_signal_fence(std::memory_order_acquire);
+        return &m_items[tail & MASK];
+    }
+
+    bool empty() const { return m_head == m_tail; }
+    uint32_t size() const { return m_head - m_tail; }
+    static constexpr uint32_t capacity() { return CAPACITY; }
+
+private:
+    static constexpr uint32_t MASK = CAPACITY - 1U;
+
+    T m_items[CAPACITY];
+    volatile uint32_t m_head = 0;   // next slot to write (producer)
+    volatile uint32_t m_tail = 0;   // next slot to read (consumer)
+};
+
+#endif // SPSC_QUEUE_H_
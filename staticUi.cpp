@@ -0,0 +1,24 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "staticUi.h"
+#include "lcdFramebuffer.h"
+
+void staticUiBlit(const StaticImage &image)
+{
+    lcdBlit(image.x, image.y, image.w, image.h, image.pixels);
+}
+
+const uint16_t *staticUiButtonFace(const char *label, bool pressed,
+                                   int32_t w, int32_t h)
+{
+    for (uint32_t i = 0; i < STATIC_UI_BUTTON_FACE_COUNT; i++) {
+        const StaticButtonFace &face = STATIC_UI_BUTTON_FACES[i];
+        if ((face.pressed == pressed) && (face.w == w) && (face.h == h) &&
+            (strcmp(face.label, label) == 0)) {
+            return face.pixels;
+        }
+    }
+    return nullptr;
+}
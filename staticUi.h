@@ -0,0 +1,56 @@
+#ifndef STATIC_UI_H_
+#define STATIC_UI_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Static UI chrome, pre-rasterized into flash
+//
+// tools/gen_static_ui.py renders the title and every button face (each
+// label, pressed and released) at build time into staticUiImages.cpp, as
+// RGB565 images in panel byte order. The title is blitted once when the
+// display comes up; a button is blitted as one image whenever its label or
+// pressed state changes, instead of being redrawn with GrLib primitives.
+//
+// The large time-readout digits are stored as a 1-bit run-length-encoded
+// font: per glyph, the runs of a cellW x cellH window in row-major order,
+// alternating background and foreground (background first), each at most
+// 255 pixels. A glyph is decoded straight into lcdSpanFill() calls, in any
+// colour pair, with no intermediate pixel buffer.
+// ============================================================================
+
+struct StaticImage {
+    int16_t x, y;           // where the image goes on screen
+    int16_t w, h;
+    const uint16_t *pixels; // w*h entries, row-major
+};
+
+struct StaticButtonFace {
+    const char *label;
+    bool pressed;
+    int16_t w, h;
+    const uint16_t *pixels;
+};
+
+struct RleFont {
+    int16_t cellW, cellH;
+    const char *glyphs;      // glyph i is glyphs[i]
+    const uint16_t *offsets; // glyph i's runs are runs[offsets[i]..offsets[i + 1])
+    const uint8_t *runs;
+};
+
+extern const StaticImage STATIC_UI_TITLE;
+extern const StaticButtonFace STATIC_UI_BUTTON_FACES[];
+extern const uint32_t STATIC_UI_BUTTON_FACE_COUNT;
+extern const RleFont STATIC_UI_LARGE_DIGITS;
+
+// Blits an image at its own position through the active LCD path.
+void staticUiBlit(const StaticImage &image);
+
+// Face for a w x h button with this label and state, or nullptr if the
+// generator did not render one (the caller then draws it with GrLib).
+const uint16_t *staticUiButtonFace(const char *label, bool pressed,
+                                   int32_t w, int32_t h);
+
+#endif // STATIC_UI_H_
@@ -0,0 +1,415 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "driverlib/gpio.h"
+#include "driverlib/sysctl.h"
+#include "inc/hw_memmap.h"
+}
+
+#include "criticalSection.h"
+#include "resultLog.h"
+#include "stopwatch.h"
+#include "telemetry.h"
+#include "timebase.h"
+
+const StopwatchInputs STOPWATCH_INPUTS_PORTM = {
+    SYSCTL_PERIPH_GPIOM, GPIO_PORTM_BASE, 0xFFU, 20U
+};
+
+// ============================================================================
+// Channel table (struct of arrays)
+// ============================================================================
+static struct {
+    uint64_t accumTicks[STOPWATCH_CHANNELS];
+    uint64_t startTicks[STOPWATCH_CHANNELS];
+    uint64_t lastToggleTicks[STOPWATCH_CHANNELS];
+    volatile uint32_t runningMask;
+
+    // Programs, in ticks; totalTicks is 0 for count-up
+    StopwatchProgram program[STOPWATCH_CHANNELS];
+    uint64_t workTicks[STOPWATCH_CHANNELS];
+    uint64_t restTicks[STOPWATCH_CHANNELS];
+    uint64_t totalTicks[STOPWATCH_CHANNELS];
+    // Channel time of the next phase boundary of a running channel, 0 for none
+    uint64_t nextBoundary[STOPWATCH_CHANNELS];
+    // Intervals: channel time at which the current round began, and its
+    // 0-based index; moved on at each boundary so nothing divides per frame
+    uint64_t roundStart[STOPWATCH_CHANNELS];
+    uint32_t round[STOPWATCH_CHANNELS];
+} sTable;
+
+static uint32_t sInputPort = 0;
+static uint8_t sInputPins = 0;
+static uint64_t sLockoutTicks = 0;
+static uint32_t sLastActive = 0;
+
+static inline uint32_t lowestBit(uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctz(mask));
+#else
+    uint32_t n = 0;
+    while ((mask & 1U) == 0U) {
+        mask >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+// ============================================================================
+// Programs
+// ============================================================================
+// Milliseconds, rounded up, so a countdown reads its full length when it
+// starts and zero only once it has run out
+static uint32_t ticksToMsUp(uint64_t ticks)
+{
+    return static_cast<uint32_t>(timebaseTicksToMs(ticks + timebaseMsToTicks(1U) - 1U));
+}
+
+// Steps a round ('start', 0-based 'index') forward a cycle at a time to the
+// one 'elapsed' falls in, or starts over from the first if 'elapsed' is
+// before it. Called at every boundary, so it is rarely more than one step.
+static void stepRound(uint64_t &start, uint32_t &index, uint64_t cycle, uint64_t elapsed)
+{
+    if (elapsed < start) {
+        start = 0U;
+        index = 0U;
+    }
+    while ((elapsed - start) >= cycle) {
+        start += cycle;
+        index++;
+    }
+}
+
+// What channel 'ch' shows at channel time 'elapsed'; interrupts masked
+static StopwatchView viewOf(uint32_t ch, uint64_t elapsed)
+{
+    const uint64_t total = sTable.totalTicks[ch];
+    StopwatchView view = {0U, PHASE_COUNTING, 0U};
+    switch (sTable.program[ch].mode) {
+    case STOPWATCH_COUNTDOWN:
+        if (elapsed >= total) {
+            view.phase = PHASE_DONE;
+        } else {
+            view.shownMs = ticksToMsUp(total - elapsed);
+        }
+        break;
+    case STOPWATCH_INTERVAL:
+        if (elapsed >= total) {
+            view.phase = PHASE_DONE;
+        } else {
+            const uint64_t work = sTable.workTicks[ch];
+            const uint64_t cycle = work + sTable.restTicks[ch];
+            uint64_t start = sTable.roundStart[ch];
+            uint32_t round = sTable.round[ch];
+            stepRound(start, round, cycle, elapsed);
+            const uint64_t pos = elapsed - start;
+            view.phase = (pos < work) ? PHASE_WORK : PHASE_REST;
+            view.shownMs = ticksToMsUp(((pos < work) ? work : cycle) - pos);
+            view.round = round + 1U;
+        }
+        break;
+    default:
+        view.shownMs = static_cast<uint32_t>(timebaseTicksToMs(elapsed));
+        break;
+    }
+    return view;
+}
+
+// Channel time of the first phase boundary after 'elapsed', 0 for none.
+// Also moves the channel's round to the one 'elapsed' falls in.
+static uint64_t boundaryAfter(uint32_t ch, uint64_t elapsed)
+{
+    const uint64_t total = sTable.totalTicks[ch];
+    if (elapsed >= total) {
+        return 0U;
+    }
+    if (sTable.program[ch].mode != STOPWATCH_INTERVAL) {
+        return total;
+    }
+    const uint64_t work = sTable.workTicks[ch];
+    const uint64_t cycle = work + sTable.restTicks[ch];
+    stepRound(sTable.roundStart[ch], sTable.round[ch], cycle, elapsed);
+    const uint64_t roundStart = sTable.roundStart[ch];
+    const uint64_t boundary = roundStart + (((elapsed - roundStart) < work) ? work : cycle);
+    return (boundary < total) ? boundary : total;
+}
+
+static void onAlarm(uint64_t nowTicks);
+
+// Points the timebase alarm at the earliest boundary of any running
+// channel. Call after every change to the table; interrupts masked.
+static void armAlarm()
+{
+    bool any = false;
+    uint64_t earliest = 0U;
+    uint32_t running = sTable.runningMask;
+    while (running != 0U) {
+        const uint32_t ch = lowestBit(running);
+        running &= running - 1U;
+        const uint64_t boundary = sTable.nextBoundary[ch];
+        if (boundary == 0U) {
+            continue;
+        }
+        const uint64_t at = sTable.startTicks[ch] + (boundary - sTable.accumTicks[ch]);
+        if (!any || (at < earliest)) {
+            earliest = at;
+            any = true;
+        }
+    }
+    if (any) {
+        timebaseSetAlarm(earliest, onAlarm);
+    } else {
+        timebaseCancelAlarm();
+    }
+}
+
+// ============================================================================
+// Channel table
+// ============================================================================
+// Every start/stop goes through here, from buttons and GPIO inputs alike,
+// so this is also where it is reported to telemetry and the result log.
+static inline void toggleChannel(uint32_t ch, uint64_t atTicks)
+{
+    const uint32_t bit = 1U << ch;
+    if (sTable.runningMask & bit) {
+        // An action stamped before the start (handlers run events from
+        // different inputs in the order they are drained) adds nothing
+        if (atTicks > sTable.startTicks[ch]) {
+            sTable.accumTicks[ch] += atTicks - sTable.startTicks[ch];
+        }
+        sTable.runningMask &= ~bit;
+        const uint32_t ms = static_cast<uint32_t>(timebaseTicksToMs(sTable.accumTicks[ch]));
+        telemetryPost(TELEM_STOP, ch, atTicks, ms);
+        resultLogAppend(RESULT_STOP, ch, 0U, ms);
+    } else {
+        // A program that has run out starts over
+        if ((sTable.totalTicks[ch] != 0U) && (sTable.accumTicks[ch] >= sTable.totalTicks[ch])) {
+            sTable.accumTicks[ch] = 0U;
+            telemetryPost(TELEM_RESET, ch, atTicks, 0U);
+            resultLogAppend(RESULT_RESET, ch, 0U, 0U);
+        }
+        sTable.startTicks[ch] = atTicks;
+        sTable.nextBoundary[ch] = boundaryAfter(ch, sTable.accumTicks[ch]);
+        sTable.runningMask |= bit;
+        telemetryPost(TELEM_START, ch, atTicks, 0U);
+    }
+}
+
+// Timebase alarm (interrupt context): applies every boundary that is due,
+// each at its own tick, and stops the channels that have run out
+static void onAlarm(uint64_t nowTicks)
+{
+    uint32_t running = sTable.runningMask;
+    while (running != 0U) {
+        const uint32_t ch = lowestBit(running);
+        running &= running - 1U;
+        for (;;) {
+            const uint64_t boundary = sTable.nextBoundary[ch];
+            if (boundary == 0U) {
+                break;
+            }
+            const uint64_t at = sTable.startTicks[ch] + (boundary - sTable.accumTicks[ch]);
+            if (at > nowTicks) {
+                break;
+            }
+            if (boundary >= sTable.totalTicks[ch]) {
+                sTable.nextBoundary[ch] = 0U;
+                toggleChannel(ch, at);
+                telemetryPost(TELEM_EXPIRE, ch, at, static_cast<uint32_t>(timebaseTicksToMs(boundary)));
+                break;
+            }
+            sTable.nextBoundary[ch] = boundaryAfter(ch, boundary);
+            const StopwatchView view = viewOf(ch, boundary);
+            telemetryPost(TELEM_PHASE, ch, at, (view.round << 8) | view.phase);
+        }
+    }
+    armAlarm();
+}
+
+// Timebase tick hook (interrupt context)
+static void sampleInputs(uint64_t nowTicks)
+{
+    const uint32_t active = ~static_cast<uint32_t>(GPIOPinRead(sInputPort, sInputPins)) & sInputPins;
+    uint32_t fell = active & ~sLastActive;
+    sLastActive = active;
+
+    bool toggled = false;
+    while (fell != 0U) {
+        const uint32_t ch = lowestBit(fell);
+        fell &= fell - 1U;
+        if ((nowTicks - sTable.lastToggleTicks[ch]) < sLockoutTicks) {
+            continue;
+        }
+        sTable.lastToggleTicks[ch] = nowTicks;
+        toggleChannel(ch, nowTicks);
+        toggled = true;
+    }
+    if (toggled) {
+        armAlarm();
+    }
+}
+
+void stopwatchChannelsInit(const StopwatchInputs &inputs)
+{
+    SysCtlPeripheralEnable(inputs.periph);
+    while (!SysCtlPeripheralReady(inputs.periph)) {
+    }
+    GPIOPinTypeGPIOInput(inputs.port, inputs.pins);
+    GPIOPadConfigSet(inputs.port, inputs.pins, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
+
+    sInputPort = inputs.port;
+    sInputPins = inputs.pins;
+    sLockoutTicks = timebaseMsToTicks(inputs.lockoutMs);
+    sLastActive = ~static_cast<uint32_t>(GPIOPinRead(inputs.port, inputs.pins)) & inputs.pins;
+    for (uint32_t ch = 0; ch < STOPWATCH_CHANNELS; ch++) {
+        sTable.program[ch] = STOPWATCH_PROGRAM_COUNT_UP;
+    }
+
+    timebaseAddTickHook(sampleInputs);
+}
+
+uint32_t stopwatchRunningMask()
+{
+    return sTable.runningMask;
+}
+
+// ============================================================================
+// Stopwatch
+// ============================================================================
+bool Stopwatch::running() const
+{
+    return (sTable.runningMask & (1U << m_channel)) != 0U;
+}
+
+void Stopwatch::start(uint64_t atTicks)
+{
+    CriticalSection cs;
+    if (!running()) {
+        toggleChannel(m_channel, atTicks);
+        armAlarm();
+    }
+}
+
+void Stopwatch::stop(uint64_t atTicks)
+{
+    CriticalSection cs;
+    if (running()) {
+        toggleChannel(m_channel, atTicks);
+        armAlarm();
+    }
+}
+
+void Stopwatch::toggle(uint64_t atTicks)
+{
+    CriticalSection cs;
+    toggleChannel(m_channel, atTicks);
+    armAlarm();
+}
+
+void Stopwatch::reset(uint64_t atTicks)
+{
+    CriticalSection cs;
+    sTable.accumTicks[m_channel] = 0U;
+    sTable.startTicks[m_channel] = atTicks;
+    sTable.nextBoundary[m_channel] = boundaryAfter(m_channel, 0U);
+    telemetryPost(TELEM_RESET, m_channel, atTicks, 0U);
+    resultLogAppend(RESULT_RESET, m_channel, 0U, 0U);
+    armAlarm();
+}
+
+void Stopwatch::restore(uint64_t accumTicks)
+{
+    CriticalSection cs;
+    if (!running()) {
+        sTable.accumTicks[m_channel] = accumTicks;
+    }
+}
+
+void Stopwatch::resume(uint64_t accumTicks, bool running, uint64_t atTicks)
+{
+    CriticalSection cs;
+    const uint32_t ch = m_channel;
+    const uint32_t bit = 1U << ch;
+    const uint64_t total = sTable.totalTicks[ch];
+    if (running && (total != 0U) && (accumTicks >= total)) {
+        accumTicks = total;
+        running = false;
+        const uint32_t ms = static_cast<uint32_t>(timebaseTicksToMs(total));
+        telemetryPost(TELEM_EXPIRE, ch, atTicks, ms);
+        resultLogAppend(RESULT_STOP, ch, 0U, ms);
+    }
+    sTable.accumTicks[ch] = accumTicks;
+    sTable.startTicks[ch] = atTicks;
+    if (running) {
+        sTable.nextBoundary[ch] = boundaryAfter(ch, accumTicks);
+        sTable.runningMask |= bit;
+    } else {
+        sTable.nextBoundary[ch] = 0U;
+        sTable.runningMask &= ~bit;
+    }
+    armAlarm();
+}
+
+void Stopwatch::setProgram(const StopwatchProgram &program, uint64_t atTicks)
+{
+    CriticalSection cs;
+    if (running()) {
+        toggleChannel(m_channel, atTicks);
+    }
+    const uint32_t ch = m_channel;
+    StopwatchProgram p = program;
+    // Nothing to count down is counting up
+    if ((p.workMs == 0U) || ((p.mode == STOPWATCH_INTERVAL) && (p.rounds == 0U))) {
+        p = STOPWATCH_PROGRAM_COUNT_UP;
+    }
+    sTable.program[ch] = p;
+    sTable.workTicks[ch] = timebaseMsToTicks(p.workMs);
+    sTable.restTicks[ch] = timebaseMsToTicks(p.restMs);
+    switch (p.mode) {
+    case STOPWATCH_COUNTDOWN:
+        sTable.totalTicks[ch] = sTable.workTicks[ch];
+        break;
+    case STOPWATCH_INTERVAL:
+        sTable.totalTicks[ch] = (sTable.workTicks[ch] + sTable.restTicks[ch]) * p.rounds -
+                                sTable.restTicks[ch];
+        break;
+    default:
+        sTable.totalTicks[ch] = 0U;
+        break;
+    }
+    sTable.accumTicks[ch] = 0U;
+    sTable.nextBoundary[ch] = 0U;
+    sTable.roundStart[ch] = 0U;
+    sTable.round[ch] = 0U;
+    armAlarm();
+}
+
+const StopwatchProgram &Stopwatch::program() const
+{
+    return sTable.program[m_channel];
+}
+
+uint64_t Stopwatch::ticksAt(uint64_t atTicks) const
+{
+    CriticalSection cs;
+    uint64_t ticks = sTable.accumTicks[m_channel];
+    if (running() && (atTicks > sTable.startTicks[m_channel])) {
+        ticks += atTicks - sTable.startTicks[m_channel];
+    }
+    return ticks;
+}
+
+uint32_t Stopwatch::elapsedMs() const
+{
+    return static_cast<uint32_t>(timebaseTicksToMs(ticksAt(timebaseNow())));
+}
+
+StopwatchView Stopwatch::viewAt(uint64_t atTicks) const
+{
+    // The alarm moves the round on
+    CriticalSection cs;
+    return viewOf(m_channel, ticksAt(atTicks));
+}
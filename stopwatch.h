@@ -0,0 +1,118 @@
+#ifndef STOPWATCH_H_
+#define STOPWATCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Stopwatch channels
+//
+// Up to STOPWATCH_CHANNELS independent stopwatches share the hardware
+// timebase. State lives in one struct-of-arrays table; a channel stores only
+// when it was started and what it had accumulated, so a running channel
+// costs nothing per tick and its time is derived when read.
+//
+// Each channel can also be toggled by an active-low GPIO input (photogate,
+// foot switch, ...). The timebase tick ISR reads all inputs with a single
+// port read and only walks the bits that changed, so idle channels add no
+// work at all. Toggles are stamped at heartbeat resolution (1 ms).
+//
+// A channel can run a program instead of counting up: a countdown, or
+// interval training (rounds of work and rest). Both count the same
+// accumulated time and only change what is shown. The end of a phase is a
+// timebase alarm set for the earliest boundary of any running channel, so
+// a countdown stops on the exact tick it runs out, with nothing polled.
+// ============================================================================
+
+static constexpr uint32_t STOPWATCH_CHANNELS = 8U;
+
+enum StopwatchMode : uint8_t {
+    STOPWATCH_COUNT_UP  = 0,
+    STOPWATCH_COUNTDOWN = 1,   // workMs, then stops
+    STOPWATCH_INTERVAL  = 2    // 'rounds' of workMs and restMs; stops after the last work
+};
+
+struct StopwatchProgram {
+    StopwatchMode mode;
+    uint32_t workMs;     // countdown length, or each work phase
+    uint32_t restMs;
+    uint32_t rounds;
+};
+
+static constexpr StopwatchProgram STOPWATCH_PROGRAM_COUNT_UP = {STOPWATCH_COUNT_UP, 0U, 0U, 0U};
+
+enum StopwatchPhase : uint8_t {
+    PHASE_COUNTING,    // count-up, or a countdown with time left
+    PHASE_WORK,
+    PHASE_REST,
+    PHASE_DONE         // a countdown or interval program has run out
+};
+
+// What a channel shows at one instant
+struct StopwatchView {
+    uint32_t shownMs;        // elapsed, or what is left of the countdown or phase
+    StopwatchPhase phase;
+    uint32_t round;          // 1-based, intervals only
+};
+
+// Channel i is toggled by bit i of the input port (falling edge).
+struct StopwatchInputs {
+    uint32_t periph;
+    uint32_t port;
+    uint8_t pins;          // which of the 8 port bits are wired
+    uint32_t lockoutMs;    // ignore re-triggers this soon after a toggle
+};
+
+// PM0..PM7 on the EK-TM4C1294XL breakout headers
+extern const StopwatchInputs STOPWATCH_INPUTS_PORTM;
+
+// Configures the input port and hooks channel sampling into the timebase
+// tick. Call after timebaseInit().
+void stopwatchChannelsInit(const StopwatchInputs &inputs);
+
+// Bit i set = channel i running
+uint32_t stopwatchRunningMask();
+
+// ============================================================================
+// CLASS: Handle to one channel
+// ============================================================================
+class Stopwatch {
+public:
+    explicit constexpr Stopwatch(uint32_t channel) : m_channel(channel) {}
+
+    uint32_t channel() const { return m_channel; }
+    bool running() const;
+
+    // All take the timebase tick at which the action happened, so captured
+    // edge times can be applied after the fact.
+    void start(uint64_t atTicks);
+    void stop(uint64_t atTicks);
+    void toggle(uint64_t atTicks);
+    void reset(uint64_t atTicks);
+
+    // Sets a stopped channel's time, e.g. from the result log at boot
+    void restore(uint64_t accumTicks);
+
+    // Puts the channel back as it was before a reset (see resumeSnapshot.h):
+    // 'accumTicks' of channel time, and still running as of 'atTicks' if
+    // 'running'. A program that ran out in the meantime ends stopped at its
+    // full length.
+    void resume(uint64_t accumTicks, bool running, uint64_t atTicks);
+
+    // Stops the channel, zeroes its time and gives it a program. Starting a
+    // channel whose program has run out starts it over.
+    void setProgram(const StopwatchProgram &program, uint64_t atTicks);
+    const StopwatchProgram &program() const;
+
+    // Stopwatch time (paused time excluded) as of 'atTicks'
+    uint64_t ticksAt(uint64_t atTicks) const;
+    uint32_t elapsedMs() const;
+
+    // What the readout shows as of 'atTicks'
+    StopwatchView viewAt(uint64_t atTicks) const;
+
+private:
+    uint32_t m_channel;
+};
+
+#endif // STOPWATCH_H_
@@ -0,0 +1,187 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "driverlib/interrupt.h"
+#include "driverlib/uart.h"
+#include "driverlib/udma.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_uart.h"
+}
+
+#include "crc8.h"
+#include "criticalSection.h"
+#include "dmaControl.h"
+#include "stopwatch.h"
+#include "telemetry.h"
+#include "timebase.h"
+
+#if TELEMETRY_ENABLE
+
+static constexpr uint32_t TX_RING_BYTES = 1024U;   // ~56 frames
+static constexpr uint32_t TX_RING_MASK  = TX_RING_BYTES - 1U;
+static constexpr uint32_t DMA_MAX_ITEMS = 1024U;   // uDMA basic-mode limit
+
+// COBS adds one code byte per frame this short, plus the 0x00 delimiter
+static constexpr uint32_t WIRE_FRAME_BYTES = TELEMETRY_FRAME_BYTES + 2U;
+
+static_assert((TX_RING_BYTES & TX_RING_MASK) == 0U, "TX ring size must be a power of two");
+
+// Ring indices run freely; head is written by posters (interrupts masked),
+// tail by the DMA-done ISR. [tail, tail + sInFlight) is on its way out.
+static uint8_t sRing[TX_RING_BYTES];
+static uint32_t sHead = 0;
+static uint32_t sTail = 0;
+static volatile uint32_t sInFlight = 0;
+
+static bool sReady = false;
+static volatile bool sHold = false;
+static uint8_t sSequence = 0;
+static volatile uint32_t sDropped = 0;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+static inline void putLe(uint8_t *out, uint64_t value, uint32_t bytes)
+{
+    for (uint32_t i = 0; i < bytes; i++) {
+        out[i] = static_cast<uint8_t>(value >> (8U * i));
+    }
+}
+
+// COBS-encodes 'frame' plus the 0x00 delimiter straight into the ring.
+// Caller has checked for WIRE_FRAME_BYTES of space.
+static void ringPutCobs(const uint8_t (&frame)[TELEMETRY_FRAME_BYTES])
+{
+    uint32_t codeAt = sHead++;
+    uint8_t code = 1U;
+    for (uint32_t i = 0; i < TELEMETRY_FRAME_BYTES; i++) {
+        if (frame[i] == 0U) {
+            sRing[codeAt & TX_RING_MASK] = code;
+            codeAt = sHead++;
+            code = 1U;
+        } else {
+            sRing[sHead++ & TX_RING_MASK] = frame[i];
+            code++;
+        }
+    }
+    sRing[codeAt & TX_RING_MASK] = code;
+    sRing[sHead++ & TX_RING_MASK] = 0U;
+}
+
+// Starts the next contiguous run of the ring. Interrupts masked.
+static void startNext()
+{
+    if (!sReady || sHold || (sInFlight != 0U) || (sHead == sTail)) {
+        return;
+    }
+
+    const uint32_t offset = sTail & TX_RING_MASK;
+    uint32_t count = sHead - sTail;
+    if (count > (TX_RING_BYTES - offset)) {
+        count = TX_RING_BYTES - offset;   // up to the end; the rest follows
+    }
+    if (count > DMA_MAX_ITEMS) {
+        count = DMA_MAX_ITEMS;
+    }
+
+    sInFlight = count;
+    uDMAChannelTransferSet(UDMA_CH9_UART0TX | UDMA_PRI_SELECT, UDMA_MODE_BASIC,
+                           &sRing[offset],
+                           reinterpret_cast<void *>(UART0_BASE + UART_O_DR),
+                           count);
+    uDMAChannelEnable(UDMA_CH9_UART0TX);
+}
+
+static void telemetryUartISR()
+{
+    UARTIntClear(UART0_BASE, UART_INT_DMATX);
+
+    CriticalSection cs;   // posts from the timebase ISR can preempt this one
+    if ((sInFlight == 0U) || uDMAChannelIsEnabled(UDMA_CH9_UART0TX)) {
+        return;
+    }
+    sTail += sInFlight;
+    sInFlight = 0U;
+    startNext();
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+void telemetryInit()
+{
+    dmaControlInit();
+
+    uDMAChannelAssign(UDMA_CH9_UART0TX);
+    uDMAChannelAttributeDisable(UDMA_CH9_UART0TX, UDMA_ATTR_ALL);
+    uDMAChannelAttributeEnable(UDMA_CH9_UART0TX, UDMA_ATTR_USEBURST);
+
+    // 8-bit items; the 16-deep TX FIFO requests DMA when half empty
+    uDMAChannelControlSet(UDMA_CH9_UART0TX | UDMA_PRI_SELECT,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE |
+                          UDMA_ARB_4);
+
+    UARTFIFOEnable(UART0_BASE);
+    UARTDMAEnable(UART0_BASE, UART_DMA_TX);
+    UARTIntRegister(UART0_BASE, telemetryUartISR);
+    UARTIntEnable(UART0_BASE, UART_INT_DMATX);
+    IntPrioritySet(INT_UART0, 0xA0);   // below the LCD; nothing waits on it
+
+    {
+        CriticalSection cs;
+        sReady = true;
+    }
+    telemetryPost(TELEM_SYNC, STOPWATCH_CHANNELS, timebaseNow(),
+                  timebaseTicksPerSecond());
+}
+
+bool telemetryPost(TelemetryEvent type, uint32_t channel, uint64_t atTicks, uint32_t arg)
+{
+    uint8_t frame[TELEMETRY_FRAME_BYTES];
+    frame[0] = type;
+    frame[1] = static_cast<uint8_t>(channel);
+    putLe(&frame[3], atTicks, 8U);
+    putLe(&frame[11], arg, 4U);
+
+    CriticalSection cs;
+    if ((TX_RING_BYTES - (sHead - sTail)) < WIRE_FRAME_BYTES) {
+        sDropped++;
+        sSequence++;   // leaves a gap the host can see
+        return false;
+    }
+    frame[2] = sSequence++;
+    frame[15] = crc8(frame, TELEMETRY_FRAME_BYTES - 1U);
+    ringPutCobs(frame);
+    startNext();
+    return true;
+}
+
+void telemetryHold(bool hold)
+{
+    if (!hold) {
+        CriticalSection cs;
+        sHold = false;
+        startNext();
+        return;
+    }
+
+    sHold = true;
+    while (sInFlight != 0U) {
+    }
+    while (UARTBusy(UART0_BASE)) {
+    }
+}
+
+bool telemetryBusy()
+{
+    return sInFlight != 0U;
+}
+
+uint32_t telemetryDropped()
+{
+    return sDropped;
+}
+
+#endif // TELEMETRY_ENABLE
@@ -0,0 +1,84 @@
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Streaming telemetry of stopwatch events
+//
+// Every start, stop, reset and lap is sent out of UART0 (the ICDI virtual
+// COM port on the EK-TM4C1294XL) with the timebase tick it happened at.
+// Posting only encodes the frame into a RAM ring; uDMA feeds the ring to the
+// UART in the background, so posting never waits on the serial line and is
+// safe from interrupts. When the ring is full the event is dropped and
+// counted rather than blocking.
+//
+// Wire format: each frame is COBS-encoded and terminated by a 0x00 byte, so
+// a receiver can join the stream at any point. Decoded, a frame is 16 bytes,
+// little-endian:
+//
+//   [0]     event type (TelemetryEvent)
+//   [1]     channel (0-based; STOPWATCH_CHANNELS for channel-less events;
+//           TELEM_LATENCY uses it for what the argument is)
+//   [2]     sequence number, +1 per posted frame (gaps = dropped frames)
+//   [3..10] timebase ticks of the event (u64)
+//   [11..14] argument (u32), see TelemetryEvent
+//   [15]    CRC-8 (poly 0x07, init 0) over bytes 0..14
+//
+// tools/telemetry_decode.py decodes the stream on the host.
+//
+// Build with TELEMETRY_ENABLE=0 to compile posting away.
+// ============================================================================
+
+#ifndef TELEMETRY_ENABLE
+#define TELEMETRY_ENABLE 1
+#endif
+
+enum TelemetryEvent : uint8_t {
+    TELEM_SYNC  = 0,   // arg = timebase ticks per second
+    TELEM_START = 1,   // arg = 0
+    TELEM_STOP  = 2,   // arg = channel time so far, ms
+    TELEM_RESET = 3,   // arg = 0
+    TELEM_LAP   = 4,   // arg = lap number (1-based)
+    TELEM_LATENCY = 5, // channel = metric * 16 + statistic, arg = count or us
+                       // (see latencyBench.h)
+    TELEM_EXPIRE = 6,  // a countdown or interval program ran out; arg = its length, ms
+    TELEM_PHASE  = 7,  // an interval phase began; arg = round * 256 + StopwatchPhase
+    TELEM_RESUME = 8,  // channels restored after a reset; arg = mask of those running
+    TELEM_BOOT   = 9   // channel = boot stage (main.cpp), arg = us since the clock was set
+};
+
+static constexpr uint32_t TELEMETRY_FRAME_BYTES = 16U;
+
+#if TELEMETRY_ENABLE
+
+// Hooks the UART0 TX DMA channel and sends a TELEM_SYNC frame. Call after
+// profilerInit() (which configures UART0) and timebaseInit().
+void telemetryInit();
+
+// Queues one event. Any context; returns false if the ring was full.
+bool telemetryPost(TelemetryEvent type, uint32_t channel, uint64_t atTicks, uint32_t arg);
+
+// While held, frames are queued but not started, so blocking text output
+// (profiler dumps) can use the UART without frames interleaving with it.
+// Waits for a transfer already in flight before returning.
+void telemetryHold(bool hold);
+
+// A transfer is in flight
+bool telemetryBusy();
+
+// Frames dropped because the ring was full
+uint32_t telemetryDropped();
+
+#else
+
+static inline void telemetryInit() {}
+static inline bool telemetryPost(TelemetryEvent, uint32_t, uint64_t, uint32_t) { return true; }
+static inline void telemetryHold(bool) {}
+static inline bool telemetryBusy() { return false; }
+static inline uint32_t telemetryDropped() { return 0U; }
+
+#endif
+
+#endif // TELEMETRY_H_
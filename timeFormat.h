@@ -0,0 +1,53 @@
+#ifndef TIME_FORMAT_H_
+#define TIME_FORMAT_H_
+
+#include <stdint.h>
+
+// ============================================================================
+// Fixed-width time formatting for the render path
+//
+// Turns a millisecond count into "HH:MM:SS.mmm" without printf or the heap:
+// only divisions by constants (which the compiler lowers to multiplies) and
+// a two-digit lookup table. Everything is constexpr so it can also run at
+// compile time.
+// ============================================================================
+
+static constexpr uint32_t TIME_TEXT_LEN = 12U;   // "HH:MM:SS.mmm"
+
+// "00", "01", ... "99"
+static constexpr char TIME_DIGIT_PAIRS[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static constexpr void timeFormatPutPair(char *out, uint32_t value)
+{
+    out[0] = TIME_DIGIT_PAIRS[value * 2U];
+    out[1] = TIME_DIGIT_PAIRS[value * 2U + 1U];
+}
+
+// Writes TIME_TEXT_LEN characters plus a terminator into 'out'. Hours wrap
+// at 100, which the 32-bit millisecond count only reaches after ~4 days.
+static constexpr void formatTimeMs(uint32_t ms, char (&out)[TIME_TEXT_LEN + 1U])
+{
+    const uint32_t totalSec = ms / 1000U;
+    const uint32_t millis   = ms - totalSec * 1000U;
+    const uint32_t totalMin = totalSec / 60U;
+    const uint32_t sec      = totalSec - totalMin * 60U;
+    const uint32_t hr       = totalMin / 60U;
+    const uint32_t min      = totalMin - hr * 60U;
+
+    timeFormatPutPair(&out[0], hr % 100U);
+    out[2] = ':';
+    timeFormatPutPair(&out[3], min);
+    out[5] = ':';
+    timeFormatPutPair(&out[6], sec);
+    out[8] = '.';
+    out[9] = static_cast<char>('0' + millis / 100U);
+    timeFormatPutPair(&out[10], millis % 100U);
+    out[TIME_TEXT_LEN] = '\0';
+}
+
+#endif // TIME_FORMAT_H_
@@ -0,0 +1,298 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <atomic>
+
+extern "C" {
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+}
+
+#ifndef SIM_BUILD
+#define SIM_BUILD 0
+#endif
+
+#if !SIM_BUILD
+// GPTMTAMR.TAMIE enables the match interrupt in periodic mode, which
+// TimerConfigure() leaves off
+static volatile uint32_t &timerModeA(uint32_t timerBase)
+{
+    return *reinterpret_cast<volatile uint32_t *>(timerBase + 0x004U);   // GPTMTAMR
+}
+static constexpr uint32_t TIMER_TAMR_TAMIE = 1U << 5;
+#endif
+
+#include "criticalSection.h"
+#include "timebase.h"
+
+TimebaseScale gTimebaseToMs = {1U, 32U};
+TimebaseScale gTimebaseToUs = {1U, 32U};
+
+static volatile uint32_t sHigh = 0;          // counter overflows
+static uint32_t sCounterBase = 0;
+static uint32_t sTickBase = 0;
+static uint32_t sTicksPerSecond = 1U;
+
+// Ticks keep the rate of the clock given to timebaseInit(). After a clock
+// change each counter count is worth sRatio ticks, counted from the switch.
+static uint64_t sSegmentTicks = 0;   // timebaseNow() at the last switch
+static uint64_t sSegmentCount = 0;   // counter value at the last switch
+static uint32_t sRatio = 1U;
+static void (*sTickHooks[TIMEBASE_MAX_TICK_HOOKS])(uint64_t) = {};
+static volatile uint32_t sTickHookCount = 0;
+
+// Alarm, as a 64-bit counter value; only touched with the counter
+// interrupt unable to run (masked, or from inside it)
+static volatile bool sAlarmArmed = false;
+static uint64_t sAlarmTicks = 0;
+static uint64_t sAlarmCount = 0;
+static void (*sAlarmCallback)(uint64_t) = nullptr;
+
+static uint64_t counterNow();
+static void armMatch();
+static uint32_t timerInterrupt(uint32_t timerBase);
+
+// ============================================================================
+// Interrupts
+// ============================================================================
+// Overflow carry, compare match, and alarms that were already due when set
+static void timebaseCounterISR()
+{
+    const uint32_t status = TimerIntStatus(sCounterBase, true);
+    TimerIntClear(sCounterBase, status);
+    if (status & TIMER_TIMA_TIMEOUT) {
+        sHigh = sHigh + 1U;
+    }
+    if (!sAlarmArmed) {
+        return;
+    }
+    if (counterNow() >= sAlarmCount) {
+        sAlarmArmed = false;
+        TimerIntDisable(sCounterBase, TIMER_TIMA_MATCH);
+        sAlarmCallback(timebaseNow());
+    } else if (status & TIMER_TIMA_TIMEOUT) {
+        armMatch();   // a new 32-bit window; the target may be in it
+    }
+}
+
+static void timebaseTickISR()
+{
+    TimerIntClear(sTickBase, TIMER_TIMA_TIMEOUT);
+
+    const uint32_t count = sTickHookCount;
+    if (count == 0U) {
+        return;
+    }
+    const uint64_t now = timebaseNow();
+    for (uint32_t i = 0; i < count; i++) {
+        sTickHooks[i](now);
+    }
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+static uint32_t timerPeripheral(uint32_t timerBase)
+{
+    switch (timerBase) {
+    case TIMER1_BASE: return SYSCTL_PERIPH_TIMER1;
+    case TIMER2_BASE: return SYSCTL_PERIPH_TIMER2;
+    case TIMER3_BASE: return SYSCTL_PERIPH_TIMER3;
+    default:          return SYSCTL_PERIPH_TIMER0;
+    }
+}
+
+static uint32_t timerInterrupt(uint32_t timerBase)
+{
+    switch (timerBase) {
+    case TIMER2_BASE: return INT_TIMER2A;
+    case TIMER3_BASE: return INT_TIMER3A;
+    default:          return INT_TIMER1A;
+    }
+}
+
+static void enableTimer(uint32_t timerBase)
+{
+    const uint32_t periph = timerPeripheral(timerBase);
+    SysCtlPeripheralEnable(periph);
+    while (!SysCtlPeripheralReady(periph)) {
+    }
+    TimerDisable(timerBase, TIMER_BOTH);
+}
+
+// Largest shift that keeps num * 2^shift / den within 32 bits. Runs once at
+// init, so the 64-bit division here is fine. The multiplier is rounded up
+// so exact multiples of a unit never come out one short.
+static TimebaseScale makeScale(uint32_t num, uint32_t den)
+{
+    TimebaseScale s = {0U, 32U};
+    for (uint32_t shift = 32U; shift < 64U; shift++) {
+        const uint64_t scaled = static_cast<uint64_t>(num) << (shift - 32U);
+        if (scaled >= (1ULL << 32)) {
+            break;
+        }
+        const uint64_t mult = ((scaled << 32) + den - 1U) / den;
+        if (mult > 0xFFFFFFFFULL) {
+            break;
+        }
+        s.mult = static_cast<uint32_t>(mult);
+        s.shift = shift;
+    }
+    return s;
+}
+
+// Counter value at which timebaseNow() reaches 'ticks', rounded up
+static uint64_t countAt(uint64_t ticks)
+{
+    if (ticks <= sSegmentTicks) {
+        return sSegmentCount;
+    }
+    const uint64_t delta = ticks - sSegmentTicks;
+    return sSegmentCount + ((sRatio == 1U) ? delta : ((delta + sRatio - 1U) / sRatio));
+}
+
+// Programs the compare match for the alarm if its count is in the current
+// 32-bit window, or pends the counter interrupt if it is already due.
+// Call with the counter interrupt unable to run.
+static void armMatch()
+{
+    TimerIntDisable(sCounterBase, TIMER_TIMA_MATCH);
+    TimerIntClear(sCounterBase, TIMER_TIMA_MATCH);
+    if (!sAlarmArmed) {
+        return;
+    }
+    const uint64_t now = counterNow();
+    if (((sAlarmCount >> 32) == (now >> 32)) && (sAlarmCount > now)) {
+        TimerMatchSet(sCounterBase, TIMER_A, static_cast<uint32_t>(sAlarmCount));
+        TimerIntEnable(sCounterBase, TIMER_TIMA_MATCH);
+    }
+    // The count may have passed the match while it was being set
+    if (counterNow() >= sAlarmCount) {
+        IntPendSet(timerInterrupt(sCounterBase));
+    }
+}
+
+// Consistent snapshot of the 64-bit hardware count
+static uint64_t counterNow()
+{
+    uint32_t hi;
+    uint32_t lo;
+    bool wrapPending;
+    do {
+        hi = sHigh;
+        lo = TimerValueGet(sCounterBase, TIMER_A);
+        wrapPending = (TimerIntStatus(sCounterBase, false) & TIMER_TIMA_TIMEOUT) != 0U;
+    } while (hi != sHigh);
+
+    // When called with interrupts masked (or from an ISR that the overflow
+    // cannot preempt) a wrap may have happened without being counted yet.
+    // A small low word means the read was after that wrap.
+    if (wrapPending && (lo < 0x80000000U)) {
+        hi++;
+    }
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+void timebaseInit(uint32_t sysClock, uint32_t counterBase, uint32_t tickBase)
+{
+    sCounterBase = counterBase;
+    sTickBase = tickBase;
+    sTicksPerSecond = sysClock;
+    sHigh = 0;
+    sSegmentTicks = 0;
+    sSegmentCount = 0;
+    sRatio = 1U;
+    sAlarmArmed = false;
+    gTimebaseToMs = makeScale(1000U, sysClock);
+    gTimebaseToUs = makeScale(1000000U, sysClock);
+
+    // Free-running 32-bit up-counter; the wrap interrupt carries into sHigh.
+    // Timekeeping outranks everything else in the firmware.
+    enableTimer(counterBase);
+    TimerConfigure(counterBase, TIMER_CFG_PERIODIC_UP);
+    TimerLoadSet(counterBase, TIMER_A, 0xFFFFFFFFU);
+#if !SIM_BUILD
+    timerModeA(counterBase) |= TIMER_TAMR_TAMIE;
+#endif
+    TimerIntRegister(counterBase, TIMER_A, timebaseCounterISR);
+    IntPrioritySet(timerInterrupt(counterBase), 0x00);
+    TimerIntEnable(counterBase, TIMER_TIMA_TIMEOUT);
+
+    // Heartbeat
+    enableTimer(tickBase);
+    TimerConfigure(tickBase, TIMER_CFG_PERIODIC);
+    TimerLoadSet(tickBase, TIMER_A, (sysClock / TIMEBASE_TICK_HZ) - 1U);
+    TimerIntRegister(tickBase, TIMER_A, timebaseTickISR);
+    IntPrioritySet(timerInterrupt(tickBase), 0x00);
+    TimerIntEnable(tickBase, TIMER_TIMA_TIMEOUT);
+
+    TimerEnable(counterBase, TIMER_A);
+    TimerEnable(tickBase, TIMER_A);
+}
+
+bool timebaseAddTickHook(void (*hook)(uint64_t nowTicks))
+{
+    const uint32_t count = sTickHookCount;
+    if (count >= TIMEBASE_MAX_TICK_HOOKS) {
+        return false;
+    }
+    // Publish the slot before the count, so the ISR never calls an empty one
+    sTickHooks[count] = hook;
+    std::atomic_signal_fence(std::memory_order_release);
+    sTickHookCount = count + 1U;
+    return true;
+}
+
+uint64_t timebaseNow()
+{
+    return sSegmentTicks + ((counterNow() - sSegmentCount) * sRatio);
+}
+
+bool timebaseSetClock(uint32_t sysClock)
+{
+    if ((sysClock == 0U) || ((sTicksPerSecond % sysClock) != 0U)) {
+        return false;
+    }
+    // Close the segment at the old rate; the few cycles since the switch
+    // itself are the only ones counted at the wrong rate.
+    const uint64_t count = counterNow();
+    sSegmentTicks = sSegmentTicks + ((count - sSegmentCount) * sRatio);
+    sSegmentCount = count;
+    sRatio = sTicksPerSecond / sysClock;
+
+    TimerLoadSet(sTickBase, TIMER_A, (sysClock / TIMEBASE_TICK_HZ) - 1U);
+
+    // Same alarm time, at the new count rate
+    if (sAlarmArmed) {
+        sAlarmCount = countAt(sAlarmTicks);
+        armMatch();
+    }
+    return true;
+}
+
+uint32_t timebaseTicksPerSecond()
+{
+    return sTicksPerSecond;
+}
+
+void timebaseSetAlarm(uint64_t atTicks, void (*callback)(uint64_t nowTicks))
+{
+    CriticalSection cs;
+    sAlarmTicks = atTicks;
+    sAlarmCount = countAt(atTicks);
+    sAlarmCallback = callback;
+    sAlarmArmed = (callback != nullptr);
+    armMatch();
+}
+
+void timebaseCancelAlarm()
+{
+    CriticalSection cs;
+    sAlarmArmed = false;
+    armMatch();
+}
@@ -0,0 +1,95 @@
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+#include <stdint.h>
+
+// ============================================================================
+// Hardware timebase
+//
+// A 32-bit GPTM counts up at the system clock and an overflow ISR extends it
+// to 64 bits, giving a free-running cycle-resolution timestamp (8.3 ns at
+// 120 MHz) that never wraps in practice. Nothing in the main loop has to run
+// for time to pass, so slow rendering cannot stretch or drop stopwatch time.
+//
+// A second timer raises a TIMEBASE_TICK_HZ periodic interrupt for work that
+// needs a steady heartbeat (input sampling, waking the core from WFI).
+//
+// One alarm can be set at an exact timestamp. It uses the counter's compare
+// match, armed once the 32-bit count reaches the window that contains the
+// target, so nothing polls for it and it fires on the cycle, not at the
+// next heartbeat.
+//
+// Ticks always run at the clock passed to timebaseInit(). When the system
+// clock is lowered (see powerManager.h) timebaseSetClock() rescales the raw
+// count, so timestamps and conversions stay valid across the switch.
+//
+// Conversions to display units use a precomputed multiply and shift instead
+// of a 64-bit division, which the M4F has no instruction for.
+// ============================================================================
+
+static constexpr uint32_t TIMEBASE_TICK_HZ = 1000U;
+
+// Multiply-shift approximation of ticks * num / ticksPerSecond
+struct TimebaseScale {
+    uint32_t mult;
+    uint32_t shift;   // always >= 32
+};
+
+// counterBase: free-running 64-bit counter; tickBase: periodic heartbeat.
+// TIMER0_BASE is owned by timerLib's Timer, so use TIMER1_BASE and up.
+void timebaseInit(uint32_t sysClock, uint32_t counterBase, uint32_t tickBase);
+
+static constexpr uint32_t TIMEBASE_MAX_TICK_HOOKS = 4U;
+
+// Adds 'hook' to the heartbeat interrupt; hooks run in the order they were
+// added. Keep them short, they run at the highest interrupt priority.
+// Returns false when all TIMEBASE_MAX_TICK_HOOKS slots are taken.
+bool timebaseAddTickHook(void (*hook)(uint64_t nowTicks));
+
+// Call with interrupts masked right after the system clock changed to
+// 'sysClock', which must divide the timebaseInit() clock. Reloads the
+// heartbeat for the new clock. Returns false (and changes nothing) for a
+// clock that does not divide evenly.
+bool timebaseSetClock(uint32_t sysClock);
+
+// Consistent 64-bit timestamp. Lock-free, and safe from thread context,
+// from any ISR and with interrupts masked.
+uint64_t timebaseNow();
+
+// Ticks per second (the system clock given to timebaseInit())
+uint32_t timebaseTicksPerSecond();
+
+// Runs 'callback' from the counter interrupt once timebaseNow() reaches
+// 'atTicks' (at once if it already has), then disarms. Replaces any alarm
+// already set; the callback may set the next one. It runs at the highest
+// interrupt priority, so keep it short.
+void timebaseSetAlarm(uint64_t atTicks, void (*callback)(uint64_t nowTicks));
+void timebaseCancelAlarm();
+
+extern TimebaseScale gTimebaseToMs;
+extern TimebaseScale gTimebaseToUs;
+
+static inline uint64_t timebaseScale(uint64_t ticks, const TimebaseScale &s)
+{
+    // 64x32-bit product (96 bits) split into two 32x32 multiplies
+    const uint64_t hi = (ticks >> 32) * s.mult;
+    const uint64_t lo = (ticks & 0xFFFFFFFFU) * s.mult;
+    return (hi + (lo >> 32)) >> (s.shift - 32U);
+}
+
+static inline uint64_t timebaseTicksToMs(uint64_t ticks)
+{
+    return timebaseScale(ticks, gTimebaseToMs);
+}
+
+static inline uint64_t timebaseTicksToUs(uint64_t ticks)
+{
+    return timebaseScale(ticks, gTimebaseToUs);
+}
+
+static inline uint64_t timebaseMsToTicks(uint32_t ms)
+{
+    return static_cast<uint64_t>(ms) * (timebaseTicksPerSecond() / 1000U);
+}
+
+#endif // TIMEBASE_H_
@@ -0,0 +1,292 @@
+#!/usr/bin/env python3
+"""Pre-rasterize the stopwatch's static UI chrome into flash images.
+
+Writes staticUiImages.cpp (see staticUi.h): the "STOPWATCH" title and every
+on-screen button face (each label, pressed and released) as RGB565 images in
+panel byte order, ready for lcdBlit(). The pixels are what the GrLib calls
+in retainedUi.cpp would produce with g_sFontFixed6x8, whose glyphs are the
+classic 5x7 set below.
+
+It also writes the time readout's large seven-segment digits as a 1-bit
+run-length-encoded font (RleFont), sized by DIGIT_W/DIGIT_H.
+
+Rerun after changing the layout, colours or labels here, in screenLayout.h
+or in main.cpp:
+
+    gen_static_ui.py -o staticUiImages.cpp
+"""
+
+import argparse
+import sys
+
+# GrLib colours (24-bit) used by the chrome
+BLACK = 0x000000
+GRAY = 0x808080
+WHITE = 0xFFFFFF
+CYAN = 0x00FFFF
+
+# g_sFontFixed6x8: 6x8 cells, 5x7 glyphs, baseline at row 7
+FONT_W = 6
+FONT_BASELINE = 7
+
+# Column-major, bit 0 at the top
+GLYPHS = {
+    " ": (0x00, 0x00, 0x00, 0x00, 0x00),
+    "A": (0x7C, 0x12, 0x11, 0x12, 0x7C),
+    "B": (0x7F, 0x49, 0x49, 0x49, 0x36),
+    "C": (0x3E, 0x41, 0x41, 0x41, 0x22),
+    "D": (0x7F, 0x41, 0x41, 0x22, 0x1C),
+    "E": (0x7F, 0x49, 0x49, 0x49, 0x41),
+    "F": (0x7F, 0x09, 0x09, 0x09, 0x01),
+    "G": (0x3E, 0x41, 0x49, 0x49, 0x7A),
+    "H": (0x7F, 0x08, 0x08, 0x08, 0x7F),
+    "I": (0x00, 0x41, 0x7F, 0x41, 0x00),
+    "J": (0x20, 0x40, 0x41, 0x3F, 0x01),
+    "K": (0x7F, 0x08, 0x14, 0x22, 0x41),
+    "L": (0x7F, 0x40, 0x40, 0x40, 0x40),
+    "M": (0x7F, 0x02, 0x0C, 0x02, 0x7F),
+    "N": (0x7F, 0x04, 0x08, 0x10, 0x7F),
+    "O": (0x3E, 0x41, 0x41, 0x41, 0x3E),
+    "P": (0x7F, 0x09, 0x09, 0x09, 0x06),
+    "Q": (0x3E, 0x41, 0x51, 0x21, 0x5E),
+    "R": (0x7F, 0x09, 0x19, 0x29, 0x46),
+    "S": (0x46, 0x49, 0x49, 0x49, 0x31),
+    "T": (0x01, 0x01, 0x7F, 0x01, 0x01),
+    "U": (0x3F, 0x40, 0x40, 0x40, 0x3F),
+    "V": (0x1F, 0x20, 0x40, 0x20, 0x1F),
+    "W": (0x3F, 0x40, 0x38, 0x40, 0x3F),
+    "X": (0x63, 0x14, 0x08, 0x14, 0x63),
+    "Y": (0x07, 0x08, 0x70, 0x08, 0x07),
+    "Z": (0x61, 0x51, 0x49, 0x45, 0x43),
+}
+
+# Layout, mirroring StopwatchLayout in screenLayout.h (128x128, 6x8 font)
+TITLE = ("STOPWATCH", 64, 15, CYAN, BLACK)   # text, centre x/y, fg, bg
+BUTTON_W = 50
+BUTTON_H = 28
+BUTTON_LABELS = ("PLAY", "PAUSE", "RESET", "LAP")
+
+# Large readout digits (FontLargeDigits in screenLayout.h)
+DIGIT_W = 10
+DIGIT_H = 16
+DIGIT_STROKE = 2
+DIGIT_GLYPHS = "0123456789:."   # DIGIT_CACHE_GLYPHS order
+
+# Lit segments per digit: a=top, b=top right, c=bottom right, d=bottom,
+# e=bottom left, f=top left, g=middle
+SEGMENTS = {
+    "0": "abcdef", "1": "bc", "2": "abdeg", "3": "abcdg", "4": "bcfg",
+    "5": "acdfg", "6": "acdefg", "7": "abc", "8": "abcdefg", "9": "abcdfg",
+}
+
+
+def panel_order(rgb):
+    """24-bit colour -> RGB565 with the bytes swapped, as lcdBlit expects."""
+    v = ((rgb & 0xF80000) >> 8) | ((rgb & 0x00FC00) >> 5) | ((rgb & 0x0000F8) >> 3)
+    return ((v & 0xFF) << 8) | (v >> 8)
+
+
+class Image:
+    def __init__(self, w, h, color):
+        self.w = w
+        self.h = h
+        self.pixels = [panel_order(color)] * (w * h)
+
+    def put(self, x, y, color):
+        if 0 <= x < self.w and 0 <= y < self.h:
+            self.pixels[y * self.w + x] = panel_order(color)
+
+    def rect(self, x0, y0, x1, y1, color):
+        for x in range(x0, x1 + 1):
+            self.put(x, y0, color)
+            self.put(x, y1, color)
+        for y in range(y0, y1 + 1):
+            self.put(x0, y, color)
+            self.put(x1, y, color)
+
+    def text(self, s, x, y, color):
+        """GrStringDraw, transparent: only set pixels are written."""
+        for i, ch in enumerate(s):
+            if ch not in GLYPHS:
+                sys.exit("gen_static_ui: no glyph for %r" % ch)
+            for col, bits in enumerate(GLYPHS[ch]):
+                for row in range(8):
+                    if bits & (1 << row):
+                        self.put(x + i * FONT_W + col, y + row, color)
+
+
+def text_width(s):
+    return len(s) * FONT_W
+
+
+def render_title():
+    text, cx, cy, fg, bg = TITLE
+    w = text_width(text)
+    img = Image(w, 8, bg)
+    img.text(text, 0, 0, fg)
+    # TextWidget centres on (cx, cy) using the full cell height
+    return cx - w // 2, cy - 8 // 2, img
+
+
+def render_button(label, pressed):
+    """drawButton(): filled face, black outline, centred label."""
+    img = Image(BUTTON_W, BUTTON_H, BLACK if pressed else GRAY)
+    img.rect(0, 0, BUTTON_W - 1, BUTTON_H - 1, BLACK)
+    x = BUTTON_W // 2 - text_width(label) // 2
+    y = BUTTON_H // 2 - FONT_BASELINE // 2
+    img.text(label, x, y, WHITE if pressed else BLACK)
+    return img
+
+
+def render_digit(ch):
+    """Seven-segment glyph as rows of booleans, one column of spacing right."""
+    bits = [[False] * DIGIT_W for _ in range(DIGIT_H)]
+
+    def fill(x0, y0, x1, y1):
+        for y in range(y0, y1 + 1):
+            for x in range(x0, x1 + 1):
+                bits[y][x] = True
+
+    t = DIGIT_STROKE
+    x0, x1 = 0, DIGIT_W - 2
+    y0, y1 = 0, DIGIT_H - 1
+    ym = (DIGIT_H - t) // 2
+    if ch == ":":
+        cx = (x0 + x1 - t + 1) // 2
+        fill(cx, DIGIT_H // 4, cx + t - 1, DIGIT_H // 4 + t - 1)
+        fill(cx, 3 * DIGIT_H // 4 - t, cx + t - 1, 3 * DIGIT_H // 4 - 1)
+        return bits
+    if ch == ".":
+        cx = (x0 + x1 - t + 1) // 2
+        fill(cx, y1 - t + 1, cx + t - 1, y1)
+        return bits
+
+    # Horizontals stop short of the corners, verticals stop short of the
+    # horizontals, so the segments stay visibly separate
+    seg = {
+        "a": (x0 + 1, y0, x1 - 1, y0 + t - 1),
+        "g": (x0 + 1, ym, x1 - 1, ym + t - 1),
+        "d": (x0 + 1, y1 - t + 1, x1 - 1, y1),
+        "f": (x0, y0 + 1, x0 + t - 1, ym - 1),
+        "b": (x1 - t + 1, y0 + 1, x1, ym - 1),
+        "e": (x0, ym + t, x0 + t - 1, y1 - 1),
+        "c": (x1 - t + 1, ym + t, x1, y1 - 1),
+    }
+    for s in SEGMENTS[ch]:
+        fill(*seg[s])
+    return bits
+
+
+def rle(bits):
+    """Row-major runs, alternating background/foreground from background.
+
+    Runs continue across rows (the decoder fills a window), and a run over
+    255 is split with an empty run of the other colour.
+    """
+    flat = [b for row in bits for b in row]
+    runs = []
+    lit = False
+    i = 0
+    while i < len(flat):
+        n = 0
+        while i < len(flat) and flat[i] == lit and n < 255:
+            n += 1
+            i += 1
+        runs.append(n)
+        lit = not lit
+    return runs
+
+
+def c_array(name, img):
+    out = ["static const uint16_t %s[%d * %d] = {" % (name, img.w, img.h)]
+    for y in range(img.h):
+        row = img.pixels[y * img.w:(y + 1) * img.w]
+        for i in range(0, len(row), 10):
+            out.append("    " + ", ".join("0x%04X" % p for p in row[i:i + 10]) + ",")
+    out.append("};")
+    return out
+
+
+def generate():
+    lines = [
+        "// Generated by tools/gen_static_ui.py; do not edit.",
+        "#include <stdint.h>",
+        "",
+        '#include "staticUi.h"',
+        '#include "screenLayout.h"',
+        "",
+    ]
+
+    tx, ty, title = render_title()
+    lines += c_array("sTitlePixels", title)
+    lines += [
+        "",
+        "const StaticImage STATIC_UI_TITLE = {%d, %d, %d, %d, sTitlePixels};" %
+        (tx, ty, title.w, title.h),
+        "",
+    ]
+
+    faces = []
+    for label in BUTTON_LABELS:
+        for pressed in (False, True):
+            name = "sButton%s%s" % (label.capitalize(), "Pressed" if pressed else "")
+            lines += c_array(name, render_button(label, pressed))
+            lines.append("")
+            faces.append((label, pressed, name))
+
+    lines.append("const StaticButtonFace STATIC_UI_BUTTON_FACES[] = {")
+    for label, pressed, name in faces:
+        lines.append('    {"%s", %s, %d, %d, %s},' %
+                     (label, "true" if pressed else "false", BUTTON_W, BUTTON_H, name))
+    lines += [
+        "};",
+        "",
+        "const uint32_t STATIC_UI_BUTTON_FACE_COUNT =",
+        "    sizeof(STATIC_UI_BUTTON_FACES) / sizeof(STATIC_UI_BUTTON_FACES[0]);",
+        "",
+    ]
+
+    runs = []
+    offsets = []
+    for ch in DIGIT_GLYPHS:
+        offsets.append(len(runs))
+        runs += rle(render_digit(ch))
+    offsets.append(len(runs))
+    lines += [
+        "static_assert((FontLargeDigits::CELL_W == %d) && (FontLargeDigits::CELL_H == %d),"
+        % (DIGIT_W, DIGIT_H),
+        '              "rerun tools/gen_static_ui.py with the layout\'s digit size");',
+        "",
+        "static const uint8_t sLargeDigitRuns[%d] = {" % len(runs),
+    ]
+    for i in range(0, len(runs), 16):
+        lines.append("    " + ", ".join("%d" % r for r in runs[i:i + 16]) + ",")
+    lines += [
+        "};",
+        "",
+        "static const uint16_t sLargeDigitOffsets[%d] = {" % len(offsets),
+        "    " + ", ".join("%d" % o for o in offsets) + ",",
+        "};",
+        "",
+        'const RleFont STATIC_UI_LARGE_DIGITS = {%d, %d, "%s", sLargeDigitOffsets,'
+        % (DIGIT_W, DIGIT_H, DIGIT_GLYPHS),
+        "                                        sLargeDigitRuns};",
+    ]
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-o", "--output", help="output file (default: stdout)")
+    args = parser.parse_args()
+
+    source = generate()
+    if args.output:
+        with open(args.output, "w", newline="\r\n") as f:
+            f.write(source)
+    else:
+        sys.stdout.write(source)
+
+
+if __name__ == "__main__":
+    main()
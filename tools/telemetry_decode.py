@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+"""Decode the stopwatch telemetry stream (see telemetry.h for the format).
+
+Reads raw bytes from a serial port (needs pyserial) or a capture file and
+prints one line per event. Text that is not a valid frame, such as a
+profiler dump sent over the same UART, is passed through unchanged.
+
+    telemetry_decode.py /dev/ttyACM0
+    telemetry_decode.py --file capture.bin
+"""
+
+import argparse
+import struct
+import sys
+
+FRAME_BYTES = 16
+EVENTS = {0: "SYNC", 1: "START", 2: "STOP", 3: "RESET", 4: "LAP", 5: "LATNC",
+          6: "EXPIR", 7: "PHASE", 8: "RESUM", 9: "BOOT"}
+LATENCY_METRICS = {0: "edge->state", 1: "edge->pixels"}  # latencyBench.h
+LATENCY_STATISTICS = {0: "count", 1: "p50", 2: "p90", 3: "p99", 4: "max"}
+PHASES = {1: "work", 2: "rest"}  # StopwatchPhase, stopwatch.h
+BOOT_STAGES = {0: "input ready", 1: "display on"}  # BootStage, main.cpp
+DEFAULT_TICKS_PER_SECOND = 120000000  # until a SYNC frame says otherwise
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data) + 1:
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def parse_frame(chunk):
+    frame = cobs_decode(chunk)
+    if frame is None or len(frame) != FRAME_BYTES or crc8(frame[:-1]) != frame[-1]:
+        return None
+    kind, channel, seq, ticks, arg = struct.unpack_from("<BBBQI", frame)
+    return kind, channel, seq, ticks, arg
+
+
+class Decoder:
+    def __init__(self, out):
+        self.out = out
+        self.pending = bytearray()
+        self.ticks_per_second = DEFAULT_TICKS_PER_SECOND
+        self.last_seq = None
+        self.lost = 0
+
+    def feed(self, data):
+        for byte in data:
+            if byte != 0:
+                self.pending.append(byte)
+                continue
+            self.chunk(bytes(self.pending))
+            self.pending.clear()
+
+    def chunk(self, chunk):
+        if not chunk:
+            return
+        parsed = parse_frame(chunk)
+        if parsed is None:
+            # Not a frame: most likely profiler text sharing the UART
+            self.out.write(chunk.decode("ascii", "replace"))
+            return
+        kind, channel, seq, ticks, arg = parsed
+
+        if self.last_seq is not None:
+            gap = (seq - self.last_seq - 1) & 0xFF
+            if gap:
+                self.lost += gap
+                self.out.write("# %d frame(s) lost\n" % gap)
+        self.last_seq = seq
+
+        if kind == 0:
+            self.ticks_per_second = arg or DEFAULT_TICKS_PER_SECOND
+            detail = "ticks/s=%d" % arg
+        elif kind == 2:
+            detail = "time=%s" % format_ms(arg)
+        elif kind == 4:
+            detail = "lap=%d" % arg
+        elif kind == 5:
+            metric = LATENCY_METRICS.get(channel >> 4, "metric%d" % (channel >> 4))
+            stat = LATENCY_STATISTICS.get(channel & 0x0F, "stat%d" % (channel & 0x0F))
+            value = ("%d" % arg) if (channel & 0x0F) == 0 else ("%.3f ms" % (arg / 1000.0))
+            detail = "%s %s=%s" % (metric, stat, value)
+        elif kind == 6:
+            detail = "length=%s" % format_ms(arg)
+        elif kind == 7:
+            phase = PHASES.get(arg & 0xFF, "phase%d" % (arg & 0xFF))
+            detail = "round=%d %s" % (arg >> 8, phase)
+        elif kind == 8:
+            detail = "running=%s" % " ".join("CH%d" % (ch + 1) for ch in range(8) if arg & (1 << ch))
+        elif kind == 9:
+            stage = BOOT_STAGES.get(channel, "stage%d" % channel)
+            detail = "%s after %.3f ms" % (stage, arg / 1000.0)
+        else:
+            detail = ""
+
+        seconds = ticks / self.ticks_per_second
+        name = EVENTS.get(kind, "EV%d" % kind)
+        where = "--" if kind in (0, 5, 8, 9) else "CH%d" % (channel + 1)
+        self.out.write("%12.6f %3d %-5s %s %s\n" % (seconds, seq, name, where, detail))
+        self.out.flush()
+
+
+def format_ms(ms):
+    hours, rest = divmod(ms, 3600000)
+    minutes, rest = divmod(rest, 60000)
+    seconds, millis = divmod(rest, 1000)
+    return "%02d:%02d:%02d.%03d" % (hours, minutes, seconds, millis)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("port", nargs="?", help="serial port, e.g. /dev/ttyACM0 or COM5")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--file", help="decode a raw capture instead of a port")
+    args = parser.parse_args()
+
+    decoder = Decoder(sys.stdout)
+    if args.file:
+        with open(args.file, "rb") as capture:
+            decoder.feed(capture.read())
+        return
+    if not args.port:
+        parser.error("give a serial port or --file")
+
+    import serial  # pyserial
+
+    with serial.Serial(args.port, args.baud, timeout=0.1) as link:
+        try:
+            while True:
+                decoder.feed(link.read(256))
+        except KeyboardInterrupt:
+            pass
+
+
+if __name__ == "__main__":
+    main()
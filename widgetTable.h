@@ -0,0 +1,255 @@
+#ifndef WIDGET_TABLE_H_
+#define WIDGET_TABLE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <type_traits>
+#include <utility>
+
+#include "retainedUi.h"
+#include "inputEvents.h"
+#include "inputSource.h"
+
+// ============================================================================
+// Declarative on-screen buttons and input bindings
+//
+// The screen's buttons are a constexpr table of ButtonSpec (geometry and
+// initial label). A ButtonPanel holds their live state and repaints only
+// the entries that differ from what is on screen, tracked as a bitmask.
+//
+// Inputs are bound at compile time: each InputBinding names an input source
+// (see inputSource.h: a switch, a photogate, a touch key), the panel button
+// it presses (or NO_WIDGET) and its handlers as template arguments, and an
+// InputTable expands the bindings into straight-line code. There is no
+// virtual call or function pointer per item at run time, and adding a
+// button is one table row plus one binding. The table debounces in the
+// heartbeat interrupt and hands events to the main loop through an
+// InputEventQueue (see inputEvents.h).
+// ============================================================================
+
+struct ButtonSpec {
+    BoxRect box;
+    const char *label;
+};
+
+static constexpr int32_t NO_WIDGET = -1;
+
+template <uint32_t N>
+class ButtonPanel {
+    static_assert((N > 0U) && (N <= 32U), "ButtonPanel tracks dirty buttons in a 32-bit mask");
+
+public:
+    explicit ButtonPanel(const ButtonSpec (&specs)[N])
+    {
+        for (uint32_t i = 0; i < N; i++) {
+            const BoxRect &box = specs[i].box;
+            m_buttons[i] = {box.x, box.y, box.w, box.h, specs[i].label, false};
+        }
+    }
+
+    void setPressed(uint32_t i, bool pressed)
+    {
+        m_buttons[i].pressed = pressed;
+        refresh(i);
+    }
+
+    // Labels are compared by pointer, so pass string literals.
+    void setLabel(uint32_t i, const char *label)
+    {
+        m_buttons[i].label = label;
+        refresh(i);
+    }
+
+    void invalidate()
+    {
+        m_stale = ALL;
+        m_dirty = ALL;
+    }
+
+    bool isDirty() const { return m_dirty != 0U; }
+    const MyButton &button(uint32_t i) const { return m_buttons[i]; }
+
+    // Repaints the buttons that differ from what is on screen. Returns true
+    // if any pixel was written.
+    bool draw(tContext &context)
+    {
+        if (m_dirty == 0U) {
+            return false;
+        }
+        for (uint32_t i = 0; i < N; i++) {
+            const uint32_t bit = 1U << i;
+            if ((m_dirty & bit) == 0U) {
+                continue;
+            }
+            drawButton(context, m_buttons[i]);
+            m_drawnLabel[i] = m_buttons[i].label;
+            m_drawnPressed = m_buttons[i].pressed ? (m_drawnPressed | bit) : (m_drawnPressed & ~bit);
+        }
+        m_stale = 0U;
+        m_dirty = 0U;
+        return true;
+    }
+
+private:
+    static constexpr uint32_t ALL = (N == 32U) ? 0xFFFFFFFFU : ((1U << N) - 1U);
+
+    // A change that is undone before the next draw() leaves nothing to paint
+    void refresh(uint32_t i)
+    {
+        const uint32_t bit = 1U << i;
+        const bool drawnPressed = (m_drawnPressed & bit) != 0U;
+        if ((m_stale & bit) || (m_buttons[i].label != m_drawnLabel[i]) ||
+            (m_buttons[i].pressed != drawnPressed)) {
+            m_dirty |= bit;
+        } else {
+            m_dirty &= ~bit;
+        }
+    }
+
+    MyButton m_buttons[N];
+    const char *m_drawnLabel[N] = {};
+    uint32_t m_drawnPressed = 0U;
+    uint32_t m_stale = ALL;    // never drawn, or invalidated
+    uint32_t m_dirty = ALL;
+};
+
+static inline void inputNoAction(uint64_t) {}
+static inline void inputNoRelease() {}
+static inline void inputNoClicks(uint64_t, uint32_t) {}
+
+// One input source wired to panel button WIDGET. sample() is the input
+// layer and runs in the timebase heartbeat; handle() runs the handlers for
+// one of its queued events in the main loop.
+//
+// ON_PRESS and ON_RELEASE run for every debounced transition, ON_LONG_PRESS
+// once a press is held for the long-press time, and ON_CLICKS when a click
+// sequence ends, with its press count. All of them get the time of the
+// (first) press that started the gesture.
+template <typename Source, Source *INPUT, int32_t WIDGET,
+          void (*ON_PRESS)(uint64_t), void (*ON_RELEASE)() = inputNoRelease,
+          void (*ON_LONG_PRESS)(uint64_t) = inputNoAction,
+          void (*ON_CLICKS)(uint64_t, uint32_t) = inputNoClicks>
+struct InputBinding {
+    static_assert(std::is_base_of<InputSource<Source>, Source>::value,
+                  "bind an InputSource (see inputSource.h)");
+
+    static void begin(const InputTiming &timing)
+    {
+        INPUT->configure(timing);
+    }
+
+    template <typename Queue>
+    static void sample(uint8_t source, uint64_t nowTicks, Queue &queue)
+    {
+        INPUT->sample(source, nowTicks, queue);
+    }
+
+    static void handle(const InputEvent &event)
+    {
+        switch (event.kind) {
+        case INPUT_PRESS:
+            ON_PRESS(event.ticks);
+            break;
+        case INPUT_RELEASE:
+            ON_RELEASE();
+            break;
+        case INPUT_LONG_PRESS:
+            ON_LONG_PRESS(event.ticks);
+            break;
+        case INPUT_CLICKS:
+            ON_CLICKS(event.ticks, event.count);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // The panel shows the debounced level (see inputEvents.h); a button
+    // several inputs press shows pressed while any of them is
+    static void addLevel(uint32_t &bound, uint32_t &pressed)
+    {
+        bound |= WIDGET_BIT;
+        if (INPUT->isPressed()) {
+            pressed |= WIDGET_BIT;
+        }
+    }
+
+private:
+    static constexpr uint32_t WIDGET_BIT = (WIDGET == NO_WIDGET) ? 0U : (1U << WIDGET);
+};
+
+template <typename... Bindings>
+struct InputTable {
+    static constexpr uint32_t COUNT = sizeof...(Bindings);
+    static_assert(COUNT <= 256U, "InputEvent::source is 8 bits");
+
+    static void begin(const InputTiming &timing)
+    {
+        const int expand[] = {0, (Bindings::begin(timing), 0)...};
+        (void)expand;
+    }
+
+    // Input layer: debounces every input and posts its events (interrupt).
+    template <typename Queue>
+    static void sample(uint64_t nowTicks, Queue &queue)
+    {
+        sampleAll(nowTicks, queue, std::make_index_sequence<COUNT>());
+    }
+
+    // Application: runs the handlers for every queued event in order, then
+    // brings the panel's pressed states up to date. Returns true if any
+    // event was handled.
+    template <typename Queue, typename Panel>
+    static bool dispatch(Queue &queue, Panel &panel)
+    {
+        const bool handled = handleAll(queue);
+        showLevels(panel);
+        return handled;
+    }
+
+    // The two halves of dispatch(), for when the handlers and the panel are
+    // owned by different tasks
+    template <typename Queue>
+    static bool handleAll(Queue &queue)
+    {
+        bool handled = false;
+        InputEvent event;
+        while (queue.pop(event)) {
+            handleOne(event, std::make_index_sequence<COUNT>());
+            handled = true;
+        }
+        return handled;
+    }
+
+    template <typename Panel>
+    static void showLevels(Panel &panel)
+    {
+        uint32_t bound = 0U;
+        uint32_t pressed = 0U;
+        const int expand[] = {0, (Bindings::addLevel(bound, pressed), 0)...};
+        (void)expand;
+        for (uint32_t i = 0; bound != 0U; i++, bound >>= 1) {
+            if (bound & 1U) {
+                panel.setPressed(i, ((pressed >> i) & 1U) != 0U);
+            }
+        }
+    }
+
+private:
+    template <typename Queue, size_t... I>
+    static void sampleAll(uint64_t nowTicks, Queue &queue, std::index_sequence<I...>)
+    {
+        const int expand[] = {0, (Bindings::sample(static_cast<uint8_t>(I), nowTicks, queue), 0)...};
+        (void)expand;
+    }
+
+    template <size_t... I>
+    static void handleOne(const InputEvent &event, std::index_sequence<I...>)
+    {
+        const int expand[] = {0, ((event.source == I) ? (Bindings::handle(event), 0) : 0)...};
+        (void)expand;
+    }
+};
+
+#endif // WIDGET_TABLE_H_